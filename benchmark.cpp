@@ -0,0 +1,249 @@
+#include "large_variables.hpp"
+#include "benchmark.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+
+// Pits the library functions against the loop you'd write if they didn't exist.
+// Single threaded (except for the parallel multiplication one), every test is just ran once. Don't take the numbers too seriously,
+// they're here to show the difference, not to be exact.
+
+// Runs the function and returns how long it took along with whatever it returned.
+template<typename Function>
+static std::pair<std::chrono::microseconds, LargeInt> time_it(Function function)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	LargeInt result = function();
+	const auto stop = std::chrono::high_resolution_clock::now();
+
+	return std::make_pair(std::chrono::duration_cast<std::chrono::microseconds>(stop - start), std::move(result));
+}
+
+static void print_comparison(const std::string& name, const std::pair<std::chrono::microseconds, LargeInt>& naive, const std::pair<std::chrono::microseconds, LargeInt>& fast)
+{
+	using namespace std;
+
+	const double naive_ms = naive.first.count() / 1000.0;
+	const double fast_ms = fast.first.count() / 1000.0;
+
+	cout << format("{:<24} naive: {:>10.3f}ms, library: {:>10.3f}ms, speedup: {:>8.1f}x", name, naive_ms, fast_ms, naive_ms / max(fast_ms, 0.001));
+
+	if (naive.second != fast.second)
+	{
+		cout << " (RESULTS DIFFER!)";
+	}
+
+	cout << endl;
+}
+
+void benchmark_factorial()
+{
+	using namespace std;
+
+	cout << "\nRunning factorial benchmark...\n";
+
+	for (uint64_t n : { 100, 500, 1000 })
+	{
+		auto naive = time_it([n]()
+		{
+			LargeInt result = 1;
+
+			for (uint64_t i = 2; i <= n; i++)
+			{
+				result *= LargeInt(i);
+			}
+
+			return result;
+		});
+
+		auto fast = time_it([n]() { return LargeInt::factorial(n); });
+
+		print_comparison(format("factorial({})", n), naive, fast);
+	}
+}
+
+void benchmark_binomial()
+{
+	using namespace std;
+
+	cout << "\nRunning binomial benchmark...\n";
+
+	for (auto [n, k] : { pair<uint64_t, uint64_t>(100, 50), pair<uint64_t, uint64_t>(1000, 10), pair<uint64_t, uint64_t>(1000, 100), pair<uint64_t, uint64_t>(2000, 300) })
+	{
+		auto naive = time_it([n, k]()
+		{
+			LargeInt result = 1;
+
+			for (uint64_t i = 0; i < k; i++)
+			{
+				result = result * LargeInt(n - i) / LargeInt(i + 1);
+			}
+
+			return result;
+		});
+
+		auto fast = time_it([n, k]() { return LargeInt::binomial(n, k); });
+
+		print_comparison(format("binomial({}, {})", n, k), naive, fast);
+	}
+}
+
+void benchmark_fibonacci()
+{
+	using namespace std;
+
+	cout << "\nRunning Fibonacci/Lucas benchmark...\n";
+
+	for (uint64_t n : { 1000, 10000, 50000 })
+	{
+		auto naive = time_it([n]()
+		{
+			LargeInt a = 0;
+			LargeInt b = 1;
+
+			for (uint64_t i = 0; i < n; i++)
+			{
+				a += b;
+				swap(a, b);
+			}
+
+			return a;
+		});
+
+		auto fast = time_it([n]() { return LargeInt::fibonacci(n); });
+
+		print_comparison(format("fibonacci({})", n), naive, fast);
+	}
+
+	for (uint64_t n : { 1000, 10000, 50000 })
+	{
+		auto naive = time_it([n]()
+		{
+			LargeInt a = 2;
+			LargeInt b = 1;
+
+			for (uint64_t i = 0; i < n; i++)
+			{
+				a += b;
+				swap(a, b);
+			}
+
+			return a;
+		});
+
+		auto fast = time_it([n]() { return LargeInt::lucas(n); });
+
+		print_comparison(format("lucas({})", n), naive, fast);
+	}
+}
+
+void benchmark_modint()
+{
+	using namespace std;
+
+	cout << "\nRunning ModInt benchmark...\n";
+
+	mt19937_64 generator(1);
+
+	for (size_t bits : { 64, 256, 1024 })
+	{
+		const LargeInt modulus = LargeInt::random_bits(bits, generator) | LargeInt(1);
+		const LargeInt base = LargeInt::random_below(modulus, generator);
+		const uint64_t count = 100;
+
+		// Chains of multiplications, reducing after every step
+		auto naive = time_it([&]()
+		{
+			LargeInt result = 1;
+
+			for (uint64_t i = 0; i < count; i++)
+			{
+				result = (result * base) % modulus;
+			}
+
+			return result;
+		});
+
+		auto fast = time_it([&]()
+		{
+			const ModInt mod_base = ModInt(base, ModInt::make_modulus(modulus));
+			ModInt result = ModInt(1, mod_base.get_modulus());
+
+			for (uint64_t i = 0; i < count; i++)
+			{
+				result *= mod_base;
+			}
+
+			return result.get_value();
+		});
+
+		print_comparison(format("{} bit, {} products", bits, count), naive, fast);
+	}
+}
+
+void benchmark_parse()
+{
+	using namespace std;
+
+	cout << "\nRunning string parsing benchmark...\n";
+
+	mt19937_64 generator(2);
+
+	for (size_t digits : { 100, 500, 1000 })
+	{
+		string str(digits, '0');
+
+		for (char& c : str)
+		{
+			c = static_cast<char>('0' + generator() % 10);
+		}
+
+		auto naive = time_it([&str]()
+		{
+			LargeInt result = 0;
+
+			for (char c : str)
+			{
+				result = result * LargeInt(10) + LargeInt(c - '0');
+			}
+
+			return result;
+		});
+
+		auto fast = time_it([&str]() { return LargeInt(str); });
+
+		print_comparison(format("{} digits", digits), naive, fast);
+	}
+}
+
+void benchmark_parallel_mul()
+{
+	using namespace std;
+
+	const unsigned int thread_budget = max(thread::hardware_concurrency(), 1u);
+
+	cout << "\nRunning parallel multiplication benchmark...\n";
+
+	mt19937_64 generator(3);
+
+	for (size_t bits : { 250000, 1000000, 4000000 })
+	{
+		const LargeInt a = LargeInt::random_bits(bits, generator);
+		const LargeInt b = LargeInt::random_bits(bits, generator);
+
+		// The same multiplication on one thread and then on all of them
+		LargeInt::set_parallel_multiplication(LargeInt::default_parallel_threshold, 1);
+		auto naive = time_it([&]() { return a * b; });
+
+		LargeInt::set_parallel_multiplication(LargeInt::default_parallel_threshold, thread_budget);
+		auto fast = time_it([&]() { return a * b; });
+
+		print_comparison(format("{} bit, {} threads", bits, thread_budget), naive, fast);
+	}
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+void benchmark_factorial();
+void benchmark_binomial();
+void benchmark_fibonacci();
+void benchmark_modint();
+void benchmark_parse();
+void benchmark_parallel_mul();
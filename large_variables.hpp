@@ -1,21 +1,144 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
 #include <climits>
 #include <cmath>
 #include <compare>
 #include <cstdint>
+#include <cstring>
+#include <exception>
 #include <format>
-#include <iosfwd>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#if defined (_MSC_VER)
+#include <intrin.h>
+#endif
+
+// SSE2 is a given on x64 (MSVC doesn't bother defining __SSE2__ there). AVX2 is only used if the compiler is told it's allowed to.
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LARGE_VARIABLES_SSE2
+#include <immintrin.h>
+#endif
+
 // using namespace std;
 // :3c
 
+class ModInt;
+class LargeIntFileReader;
+class LargeIntFileWriter;
+class LargeIntLeaf;
+template<typename Left, typename Right, char op>
+class LargeIntExpr;
+template<size_t Limbs>
+class LargeIntConstant;
+
+// A read only view of a number that lives in memory owned by something else (a mapped file, a network buffer, an arena...),
+// as its magnitude in 64-bit limbs, least significant first, plus a sign. Nothing gets copied, so the memory has to outlive the view.
+// LargeInt takes a view anywhere it takes another LargeInt on the right hand side, and LargeInt(view) makes an owning copy.
+class LargeIntView
+{
+public:
+	// A view of 0.
+	constexpr LargeIntView() noexcept = default;
+
+	// Leading zero limbs are skipped, and -0 is just 0.
+	constexpr LargeIntView(std::span<const uint64_t> limbs, bool negative = false) noexcept : limbs(limbs), negative(negative)
+	{
+		while (!this->limbs.empty() && this->limbs.back() == 0)
+		{
+			this->limbs = this->limbs.first(this->limbs.size() - 1);
+		}
+
+		this->negative = negative && !this->limbs.empty();
+	}
+
+	// Get the limbs of the magnitude. There are never any leading zero ones, so 0 has none at all.
+	constexpr std::span<const uint64_t> get_limbs() const noexcept
+	{
+		return limbs;
+	}
+
+	constexpr bool is_negative() const noexcept
+	{
+		return negative;
+	}
+
+	// Get the number of bits in the magnitude. Unlike LargeInt::bit_length(), -256 has a bit length of 9 here.
+	constexpr size_t bit_length() const noexcept
+	{
+		return (limbs.empty() ? 0 : limbs.size() * 64 - std::countl_zero(limbs.back()));
+	}
+
+	// Same memory, opposite sign.
+	constexpr LargeIntView operator-() const noexcept
+	{
+		return LargeIntView(limbs, !negative);
+	}
+
+	constexpr LargeIntView abs() const noexcept
+	{
+		return LargeIntView(limbs, false);
+	}
+
+	constexpr std::weak_ordering operator<=>(const LargeIntView& other) const noexcept
+	{
+		if (negative != other.negative)
+		{
+			return (negative ? std::weak_ordering::less : std::weak_ordering::greater);
+		}
+
+		const std::weak_ordering magnitude = compare_magnitude(other);
+		return (negative ? 0 <=> magnitude : magnitude);
+	}
+
+	constexpr bool operator==(const LargeIntView& other) const noexcept
+	{
+		return negative == other.negative && std::equal(limbs.begin(), limbs.end(), other.limbs.begin(), other.limbs.end());
+	}
+
+private:
+	std::span<const uint64_t> limbs;
+	bool negative = false;
+
+	constexpr std::weak_ordering compare_magnitude(const LargeIntView& other) const noexcept
+	{
+		if (limbs.size() != other.limbs.size())
+		{
+			return limbs.size() <=> other.limbs.size();
+		}
+
+		for (size_t i = limbs.size(); i > 0; i--)
+		{
+			if (limbs[i - 1] != other.limbs[i - 1])
+			{
+				return limbs[i - 1] <=> other.limbs[i - 1];
+			}
+		}
+
+		return std::weak_ordering::equivalent;
+	}
+};
+
 // An arbitrarily sized integer value.
 // Theoretically can be as big as your memory allows, unless specifying a max size that is less than that.
 // The value is ALWAYS treated as if it's signed. Thus, size 1 is limited to -128 - +127; size 2 is limited to -32768 - +32767; etc.
@@ -51,8 +174,47 @@ public:
 		invalid_float_conversion(const invalid_float_conversion& other) = default;
 	};
 
+	// Throwable class for when a string given to the constructor isn't a number (i.e it's empty or has characters that aren't digits in the base)
+	class invalid_string_conversion : public std::logic_error
+	{
+	public:
+		invalid_string_conversion(const std::string& what_arg) : logic_error(what_arg)
+		{}
+
+		invalid_string_conversion(const char* what_arg) : logic_error(what_arg)
+		{}
+
+		invalid_string_conversion(const invalid_string_conversion& other) = default;
+	};
+
+	// Throwable class for when deserialize() is given bytes that aren't a serialized number (i.e they're cut off or the varint is too long)
+	class invalid_serialization : public std::logic_error
+	{
+	public:
+		invalid_serialization(const std::string& what_arg) : logic_error(what_arg)
+		{}
+
+		invalid_serialization(const char* what_arg) : logic_error(what_arg)
+		{}
+
+		invalid_serialization(const invalid_serialization& other) = default;
+	};
+
+	// Throwable class for when a modular inverse is asked for but doesn't exist (i.e gcd(a, m) != 1)
+	class not_invertible : public std::logic_error
+	{
+	public:
+		not_invertible(const std::string& what_arg) : logic_error(what_arg)
+		{}
+
+		not_invertible(const char* what_arg) : logic_error(what_arg)
+		{}
+
+		not_invertible(const not_invertible& other) = default;
+	};
+
 	// Default constructor that initializes the class with a value of 0.
-	LargeInt() : value(0), size(1), max_size(0)
+	LargeInt() : value(1, 0), size(1), max_size(0)
 	{}
 
 	// Almost a copy constructor except it doesn't copy max size.
@@ -61,8 +223,11 @@ public:
 	{}
 
 	// Constructor for using a byte vector (since that's basically what the class is).
+	// Redundant sign bytes on top are trimmed off.
 	explicit LargeInt(const std::vector<uint8_t>& other) : value(other), size(other.size()), max_size(0)
-	{}
+	{
+		trim_size();
+	}
 
 	// Constructor for using a byte vector (since that's basically what the class is).
 	// If the number would take up more bytes than the max size, excess bytes are truncated.
@@ -71,6 +236,10 @@ public:
 		trim_size();
 	}
 
+	// Copies the number out of a view.
+	explicit LargeInt(const LargeIntView& view) : LargeInt(view, 0)
+	{}
+
 	// me when LargeInt num = true;
 	explicit LargeInt(bool val) : value({ static_cast<uint8_t>(val) }), size(sizeof(uint8_t)), max_size(0)
 	{}
@@ -86,6 +255,11 @@ public:
 	explicit LargeInt(FloatingPoint val) : LargeInt(val, 0)
 	{}
 
+	// Copies the number out of a view.
+	// If the number would take up more bytes than the max size, excess bytes are truncated.
+	LargeInt(const LargeIntView& view, size_t max_size) : LargeInt(from_limb_span(view.get_limbs().data(), view.get_limbs().size(), view.is_negative(), max_size))
+	{}
+
 	// me when LargeInt(true, n);
 	LargeInt(bool val, size_t max_size) : value({ static_cast<uint8_t>(val) }), size(sizeof(uint8_t)), max_size(max_size)
 	{
@@ -96,100 +270,46 @@ public:
 	// Constructor for integer types that aren't a boolean.
 	// If the number would take up more bytes than the max size, excess bytes are truncated.
 	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true, std::enable_if_t<!std::is_same<Integer, bool>::value, bool> = true>
-	LargeInt(Integer val, size_t max_size) : size(0), max_size(max_size)
+	LargeInt(Integer val, size_t max_size) : value(sizeof(Integer) + 1, 0), size(sizeof(Integer) + 1), max_size(max_size)
 	{
-		const bool is_val_negative = val < 0;
-
-		if (val == 0)
-		{
-			value.push_back(0);
-			size++;
-		}
-
+		// The extra byte on top is the sign, so unsigned numbers with their top bit set stay positive.
 		if constexpr (std::numeric_limits<Integer>::is_signed)
 		{
-			while (!too_large(size + 1) && val != 0 && val != -1)
+			if (val < 0)
 			{
-				const uint8_t num = static_cast<uint8_t>(val);
-				value.push_back(num);
-				val >>= byte_bits;
-				size++;
-			}
-			if (val == -1)
-			{
-				value.push_back(UINT8_MAX);
-				size++;
+				value.back() = UINT8_MAX;
 			}
 		}
+
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			std::memcpy(value.data(), &val, sizeof(Integer));
+		}
 		else
 		{
-			// i blame gcc
-			while (!too_large(size + 1) && val != 0)
+			for (size_t i = 0; i < sizeof(Integer); i++)
 			{
-				const uint8_t num = static_cast<uint8_t>(val);
-				value.push_back(num);
-				val >>= byte_bits;
-				size++;
+				value[i] = static_cast<uint8_t>(static_cast<std::make_unsigned_t<Integer>>(val) >> (byte_bits * i));
 			}
 		}
 
-		if (is_negative() && !is_val_negative)
-		{
-			value.push_back(0);
-			size++;
-		}
-
 		trim_size();
 	}
 
-	// Constructor for floating point types.
+	// Constructor for floating point types. The fractional part is dropped.
 	// Throws invalid_float_conversion if the float given is inf or NaN.
 	// If the number would take up more bytes than the max size, excess bytes are truncated.
 	template<typename FloatingPoint, std::enable_if_t<std::is_floating_point<FloatingPoint>::value, bool> = true>
-	LargeInt(FloatingPoint val, size_t max_size) : size(0), max_size(max_size)
-	{
-		if (std::isinf(val))
-		{
-			throw invalid_float_conversion("Cannot convert infinity to LargeInt.");
-		}
-		else if (std::isnan(val))
-		{
-			throw invalid_float_conversion("Cannot convert NaN to LargeInt.");
-		}
-
-		val = trunc(val);
-		const bool is_val_negative = val < 0;
-
-		if (val == 0)
-		{
-			value.push_back(0);
-			size++;
-		}
-
-		val = std::abs(val);
-
-		while (!too_large(size + 1) && val != 0)
-		{
-			// fmod seems to give better results than casting to byte directly
-			const uint8_t num = static_cast<uint8_t>(fmod(val, static_cast<FloatingPoint>(pow(2, byte_bits))));
-			value.push_back(num);
-			val = trunc(val / static_cast<FloatingPoint>(pow(2, byte_bits)));
-			size++;
-		}
-
-		if (is_negative())
-		{
-			value.push_back(0);
-			size++;
-		}
+	LargeInt(FloatingPoint val, size_t max_size) : LargeInt(from_float(val, max_size))
+	{}
 
-		if (is_val_negative)
-		{
-			*this = -*this;
-		}
+	// Constructor for strings of digits in any base from 2 to 36, optionally starting with a sign. See from_string().
+	explicit LargeInt(std::string_view str, int base = 10) : LargeInt(from_string(str, base))
+	{}
 
-		trim_size();
-	}
+	// Without this string literals would go for the bool constructor.
+	explicit LargeInt(const char* str, int base = 10) : LargeInt(std::string_view(str), base)
+	{}
 
 	// Changes the maximum size of the value and truncates if it's too large.
 	void change_max_size(size_t new_size)
@@ -199,39 +319,32 @@ public:
 	}
 
 	// +x is the same as x so this just returns a copy of the value.
-	LargeInt operator+() const
+	LargeInt operator+() const &
 	{
 		return *this;
 	}
 
+	LargeInt operator+() &&
+	{
+		return std::move(*this);
+	}
+
 	// Creates a copy where the value is negated (based on the two's complement) and returns it.
-	LargeInt operator-() const
+	LargeInt operator-() const &
 	{
 		LargeInt new_val = *this;
+		new_val.negate();
 
-		bool carry = true;
-		for (auto& iter : new_val.value)
-		{
-			iter ^= UINT8_MAX;
-
-			if (carry)
-			{
-				const uint8_t current = iter;
-				iter++;
-				carry = iter < current;
-			}
-		}
-
-		if (new_val.is_negative() && is_negative())
-		{
-			new_val.value.push_back(0);
-			new_val.size++;
-		}
-
-		new_val.trim_size();
 		return new_val;
 	}
 
+	// Temporaries get negated in place.
+	LargeInt operator-() &&
+	{
+		negate();
+		return std::move(*this);
+	}
+
 	// Copies the value without changing the max size.
 	LargeInt& copy_value(const LargeInt& other)
 	{
@@ -243,208 +356,122 @@ public:
 	}
 
 	// Adds two numbers.
-	LargeInt operator+(LargeInt other) const
+	// The rvalue overloads add into the temporary's buffer and hand it back, so a chain like ((a + b) + c) + d only allocates once.
+	LargeInt operator+(const LargeInt& other) const &
 	{
 		LargeInt new_val = *this;
+		new_val += other;
 
-		// If the sign of the two numbers is different, i.e we're effectively subtracting two numbers,
-		// temporarily change the result's max size so that the carry bit is correctly discarded.
-		if (new_val.is_negative() != other.is_negative())
-		{
-			new_val.change_max_size(std::max(size, other.size));
-		}
-
-		// If either number is negative, expand it to be the same size as the other
-		// so the operation is carried out correctly without a bunch of extra checks
-		while (new_val.is_negative() && new_val.size < other.size)
-		{
-			new_val.value.push_back(UINT8_MAX);
-			new_val.size++;
-		}
-
-		while (other.is_negative() && other.size < new_val.size)
-		{
-			other.value.push_back(UINT8_MAX);
-			other.size++;
-		}
-
-		size_t index = 0;
-		bool carry = false;
-
-		for (; (index == 0 || !too_large(index - 1)) && index < other.value.size(); index++)
-		{
-			// Expand the value so we don't index out of bounds
-			if (index >= new_val.value.size())
-			{
-				new_val.value.push_back(0);
-				new_val.size++;
-			}
-
-			// Since unsigned integer overflow is well defined, we should be able
-			// to detect it by checking if the value *decreased* after adding to it.
-			// If an overflow was detected, set a carry flag so we add 1 to the next byte.
-			uint8_t current = new_val.value[index];
-			if (carry)
-			{
-				new_val.value[index]++;
-				carry = (new_val.value[index] < current);
-				current = new_val.value[index];
-			}
-			new_val.value[index] += other.value[index];
-			carry = carry || new_val.value[index] < current;
-		}
-
-		// Make sure the carry is processed even after we're done adding.
-		for (; (index == 0 || !too_large(index - 1)) && carry; index++)
-		{
-			if (index >= new_val.value.size())
-			{
-				// Negative numbers work differently. Need to not infinitely add 1 to 255.
-				if (is_negative() && other.is_negative())
-				{
-					new_val.value.push_back(UINT8_MAX);
-					new_val.size++;
-					carry = false;
-					break;
-				}
-				else
-				{
-					new_val.value.push_back(0);
-					new_val.size++;
-				}
-			}
-
-			const uint8_t current = new_val.value[index];
-			new_val.value[index]++;
-			carry = (new_val.value[index] < current);
-		}
+		return new_val;
+	}
 
-		// Make sure the resulting value has a sign that makes sense.
-		if (!is_negative() && !other.is_negative() && new_val.is_negative())
-		{
-			new_val.value.push_back(0);
-			new_val.size++;
-		}
-		else if (is_negative() && other.is_negative() && !new_val.is_negative())
-		{
-			for (size_t i = new_val.value.size() - 1; i != SIZE_MAX; i--)
-			{
-				new_val.value[i] ^= UINT8_MAX;
-			}
+	LargeInt operator+(const LargeInt& other) &&
+	{
+		*this += other;
+		return std::move(*this);
+	}
 
-			carry = true;
+	LargeInt operator+(LargeInt&& other) const &
+	{
+		// Addition commutes so the right side's buffer works just as well, but the result still gets this side's max size.
+		other.max_size = max_size;
+		other += *this;
 
-			for (size_t i = 0; i < new_val.value.size() && carry; i++)
-			{
-				const uint8_t current = new_val.value[i];
-				new_val.value[i]++;
-				carry = (new_val.value[i] < current);
-			}
-		}
+		return std::move(other);
+	}
 
-		new_val.trim_size();
+	LargeInt operator+(LargeInt&& other) &&
+	{
+		*this += other;
+		return std::move(*this);
+	}
 
-		// Revert the max size change when subtracting numbers
-		if (is_negative() != other.is_negative())
-		{
-			new_val.change_max_size(max_size);
-			new_val.trim_size();
-		}
+	LargeInt& operator+=(const LargeInt& other)
+	{
+		add_assign<add_op::add>(other);
+		return *this;
+	}
 
-		return new_val;
+	// Adds a viewed number, reading its limbs in place.
+	LargeInt operator+(const LargeIntView& other) const
+	{
+		return add_magnitude(other.get_limbs(), other.is_negative());
 	}
 
-	LargeInt& operator+=(const LargeInt& other)
+	LargeInt& operator+=(const LargeIntView& other)
 	{
 		*this = *this + other;
 		return *this;
 	}
 
-	// Subtracts two numbers.
-	LargeInt operator-(LargeInt other) const
+	// Subtracts two numbers. Same deal as addition with the rvalue overloads.
+	LargeInt operator-(const LargeInt& other) const &
 	{
-		// Save some stuff that we're about to change
-		const size_t other_max_size = other.max_size;
-		const bool other_was_negative = other.is_negative();
-		other.change_max_size(other.size);
-
-		// Negate the other number
-		for (size_t i = other.value.size() - 1; i != SIZE_MAX; i--)
-		{
-			other.value[i] ^= UINT8_MAX;
-		}
+		LargeInt new_val = *this;
+		new_val -= other;
 
-		bool carry = true;
+		return new_val;
+	}
 
-		for (size_t i = 0; i < other.value.size() && carry; i++)
-		{
-			const uint8_t current = other.value[i];
-			other.value[i]++;
-			carry = (other.value[i] < current);
-		}
+	LargeInt operator-(const LargeInt& other) &&
+	{
+		*this -= other;
+		return std::move(*this);
+	}
 
-		other.trim_size();
+	LargeInt operator-(LargeInt&& other) const &
+	{
+		// Subtract the right side from this one straight into its buffer.
+		other.max_size = max_size;
+		other.add_assign<add_op::reverse_subtract>(*this);
 
-		// Revert the max size change
-		other.change_max_size(other_max_size);
+		return std::move(other);
+	}
 
-		// Expand the number if we happened to get the exact same value (like trying to negate -128)
-		if (other_was_negative && other.is_negative())
-		{
-			other.value.push_back(0);
-		}
+	LargeInt operator-(LargeInt&& other) &&
+	{
+		*this -= other;
+		return std::move(*this);
+	}
 
-		other.trim_size();
+	LargeInt& operator-=(const LargeInt& other)
+	{
+		add_assign<add_op::subtract>(other);
+		return *this;
+	}
 
-		// Now just add the two numbers together
-		return *this + other;
+	// Subtracts a viewed number, reading its limbs in place.
+	LargeInt operator-(const LargeIntView& other) const
+	{
+		return add_magnitude(other.get_limbs(), !other.is_negative());
 	}
 
-	LargeInt& operator-=(const LargeInt& other)
+	LargeInt& operator-=(const LargeIntView& other)
 	{
 		*this = *this - other;
 		return *this;
 	}
 
-	// Multiplies two numbers.
+	// Multiplies two numbers on their limbs (see limbs_mul()), which is where the fast and parallel multiplication lives.
 	LargeInt operator*(const LargeInt& other) const
 	{
-		LargeInt new_val(0, max_size);
-
-		// Expand the new value so we don't index out of bounds
-		while (new_val.size < size + other.size)
-		{
-			new_val.value.push_back(0);
-			new_val.size++;
-		}
-
-		// Take the absolute values (because negative numbers will probably fuck shit up)
-		LargeInt abs_val = LargeInt(*this, 0).abs();
-		LargeInt abs_other = LargeInt(other, 0).abs();
-
-		// Sequentially multiply each set of two bytes together,
-		// adding the result to the new value, bit shifted to be in the correct place.
-		for (size_t right = 0; right < other.size; right++)
-		{
-			for (size_t left = 0; left < size; left++)
-			{
-				LargeInt result = static_cast<uint16_t>(abs_val.value[left]) * abs_other.value[right];
-				result <<= ((left + right) * byte_bits);
-				new_val += result;
-			}
-		}
+		const limb_vector b = other.to_limbs();
+		return multiply_magnitude(b, other.is_negative());
+	}
 
-		// Sort out negatives
-		if (is_negative() != other.is_negative())
-		{
-			new_val = -new_val;
-		}
+	LargeInt& operator*=(const LargeInt& other)
+	{
+		*this = *this * other;
+		return *this;
+	}
 
-		new_val.trim_size();
-		return new_val;
+	// Multiplies by a viewed number, reading its limbs in place.
+	LargeInt operator*(const LargeIntView& other) const
+	{
+		return multiply_magnitude(other.get_limbs(), other.is_negative());
 	}
 
-	LargeInt& operator*=(const LargeInt& other)
+	LargeInt& operator*=(const LargeIntView& other)
 	{
 		*this = *this * other;
 		return *this;
@@ -507,7 +534,23 @@ public:
 		return *this;
 	}
 
-	// Modulos two numbers
+	// Divides by a viewed number. Rounds towards 0 like the built in types.
+	// The divisor still gets copied, since the division normalizes it in a scratch copy anyway.
+	LargeInt operator/(const LargeIntView& other) const
+	{
+		const limb_vector divisor(other.get_limbs().begin(), other.get_limbs().end());
+		const limb_vector quotient = mag_divmod(to_limbs(), divisor, nullptr);
+
+		return from_limb_span(quotient.data(), quotient.size(), is_negative() != other.is_negative(), max_size);
+	}
+
+	LargeInt& operator/=(const LargeIntView& other)
+	{
+		*this = *this / other;
+		return *this;
+	}
+
+	// Modulos two numbers
 	LargeInt operator%(const LargeInt& other) const
 	{
 		if (other == 0)
@@ -555,281 +598,235 @@ public:
 		return *this;
 	}
 
-	// Does a bitwise and operation between two numbers.
-	LargeInt operator&(const LargeInt& other) const
+	// Modulos by a viewed number. The result has the sign of this number like the built in types.
+	LargeInt operator%(const LargeIntView& other) const
 	{
-		LargeInt new_val = *this;
-		const bool val_is_negative = new_val.is_negative();
+		const limb_vector divisor(other.get_limbs().begin(), other.get_limbs().end());
+		limb_vector remainder;
+		mag_divmod(to_limbs(), divisor, &remainder);
 
-		for (size_t i = 0; (new_val.max_size == 0 || i < new_val.max_size) && (i < new_val.size || i < other.size); i++)
-		{
-			// If in bounds, don't need to do anything special.
-			if (i < new_val.size && i < other.size)
-			{
-				new_val.value[i] &= other.value[i];
-			}
-			// If the other number is smaller and positive, gotta set the rest of this to 0.
-			// Negative is ignored because any byte & 255 doesn't change.
-			else if (i < new_val.size && !other.is_negative())
-			{
-				new_val.value[i] = 0;
-			}
-			// If this number is smaller and negative, add the rest of the other number's bytes.
-			else if (i < other.size && val_is_negative)
-			{
-				new_val.value.push_back(other.value[i]);
-			}
-			else
-			{
-				break;
-			}
-		}
+		return from_limb_span(remainder.data(), remainder.size(), is_negative(), max_size);
+	}
 
-		new_val.recalculate_size();
+	LargeInt& operator%=(const LargeIntView& other)
+	{
+		*this = *this % other;
+		return *this;
+	}
+
+	// Does a bitwise and operation between two numbers. Temporaries on either side get reused like with addition.
+	LargeInt operator&(const LargeInt& other) const &
+	{
+		LargeInt new_val = *this;
+		new_val &= other;
 
 		return new_val;
 	}
 
+	LargeInt operator&(const LargeInt& other) &&
+	{
+		*this &= other;
+		return std::move(*this);
+	}
+
+	LargeInt operator&(LargeInt&& other) const &
+	{
+		other.max_size = max_size;
+		other &= *this;
+
+		return std::move(other);
+	}
+
+	LargeInt operator&(LargeInt&& other) &&
+	{
+		*this &= other;
+		return std::move(*this);
+	}
+
 	LargeInt& operator&=(const LargeInt& other)
 	{
-		*this = *this & other;
+		bitwise_assign<bitwise_op::bit_and>(other);
 		return *this;
 	}
 
-	// Does a bitwise or operation between two numbers.
-	LargeInt operator|(const LargeInt& other) const
+	LargeInt operator&(const LargeIntView& other) const
 	{
 		LargeInt new_val = *this;
-		const bool val_is_negative = new_val.is_negative();
+		new_val &= other;
 
-		for (size_t i = 0; (new_val.max_size == 0 || i < new_val.max_size) && (i < new_val.size || i < other.size); i++)
-		{
-			// If within bounds, do nothing special.
-			if (i < new_val.size && i < other.size)
-			{
-				new_val.value[i] |= other.value[i];
-			}
-			// If the other number is smaller and negative,
-			// set the rest of the bytes to 255. They'll be trimmed later.
-			else if (i < new_val.size && other.is_negative())
-			{
-				new_val.value[i] = UINT8_MAX;
-			}
-			// If this nubmer is smaller and not negative, add the rest of the other number's bytes.
-			// If this number is negative, then it's ignored because adding extra 255 bytes doesn't change the value.
-			else if (i < other.size && !val_is_negative)
-			{
-				new_val.value.push_back(other.value[i]);
-			}
-			else
-			{
-				break;
-			}
-		}
+		return new_val;
+	}
 
-		new_val.trim_size();
+	LargeInt& operator&=(const LargeIntView& other)
+	{
+		bitwise_assign<bitwise_op::bit_and>(other);
+		return *this;
+	}
+
+	// Does a bitwise or operation between two numbers.
+	LargeInt operator|(const LargeInt& other) const &
+	{
+		LargeInt new_val = *this;
+		new_val |= other;
 
 		return new_val;
 	}
 
+	LargeInt operator|(const LargeInt& other) &&
+	{
+		*this |= other;
+		return std::move(*this);
+	}
+
+	LargeInt operator|(LargeInt&& other) const &
+	{
+		other.max_size = max_size;
+		other |= *this;
+
+		return std::move(other);
+	}
+
+	LargeInt operator|(LargeInt&& other) &&
+	{
+		*this |= other;
+		return std::move(*this);
+	}
+
 	LargeInt& operator|=(const LargeInt& other)
 	{
-		*this = *this | other;
+		bitwise_assign<bitwise_op::bit_or>(other);
 		return *this;
 	}
 
-	// Does a bitwise xor operation between two numbers.
-	LargeInt operator^(const LargeInt& other) const
+	LargeInt operator|(const LargeIntView& other) const
 	{
 		LargeInt new_val = *this;
-		const bool val_is_negative = new_val.is_negative();
-
-		for (size_t i = 0; (new_val.max_size == 0 || i < new_val.max_size) && (i < other.size || i < new_val.size); i++)
-		{
-			// If within bounds, do nothing special.
-			if (i < new_val.size && i < other.size)
-			{
-				new_val.value[i] ^= other.value[i];
-			}
-			// If the other number is smaller and negative, invert this number's bits.
-			else if (i < new_val.size && other.is_negative())
-			{
-				new_val.value[i] = ~new_val.value[i];
-			}
-			// If this number is smaller and negative, add the other number's bits inverted.
-			else if (i < other.size && val_is_negative)
-			{
-				new_val.value.push_back(~other.value[i]);
-				new_val.size++;
-			}
-			// If this number is smaller and positive, add the other number's bits
-			else if (i < other.size)
-			{
-				new_val.value.push_back(other.value[i]);
-				new_val.size++;
-			}
-			else
-			{
-				break;
-			}
-		}
-
-		new_val.trim_size();
+		new_val |= other;
 
 		return new_val;
 	}
 
-	LargeInt& operator^=(const LargeInt& other)
+	LargeInt& operator|=(const LargeIntView& other)
 	{
-		*this = *this ^ other;
+		bitwise_assign<bitwise_op::bit_or>(other);
 		return *this;
 	}
 
-	// Left shifts the number by the specified amount of bits
-	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
-	LargeInt operator<<(const Integer& other) const
+	// Does a bitwise xor operation between two numbers.
+	LargeInt operator^(const LargeInt& other) const &
 	{
-		// If a negative number was given, do the opposite bit shift operation.
-		if constexpr (std::is_signed<Integer>::value)
-		{
-			if (other < 0)
-			{
-				return *this >> -other;
-			}
-		}
-
-		size_t other_size = static_cast<size_t>(other);
 		LargeInt new_val = *this;
-		const bool val_is_negative = new_val.is_negative();
+		new_val ^= other;
 
-		// If the number of shifts is larger than the max amount of bits, return a value of 0.
-		if (new_val.max_size != 0 && other_size > new_val.max_size * byte_bits)
-		{
-			new_val.value.clear();
-			new_val.value.push_back(0);
-			return new_val;
-		}
+		return new_val;
+	}
 
-		// For multiples of 8 bits, simply add another byte to the beginning.
-		for (; other_size >= byte_bits; other_size -= byte_bits)
-		{
-			new_val.value.insert(new_val.value.begin(), 0);
-			new_val.size++;
-		}
+	LargeInt operator^(const LargeInt& other) &&
+	{
+		*this ^= other;
+		return std::move(*this);
+	}
 
-		for (; other_size > 0; other_size--)
-		{
-			// If the number isn't negative and we would shift a 1 from bit 7 to bit 8, expand the value to keep it positive.
-			if (!val_is_negative && (new_val.value[new_val.value.size() - 1] & (1 << (byte_bits - 2))) != 0)
-			{
-				new_val.value.push_back(0);
-				new_val.size++;
-			}
-			// If the number is negative and we would shift a 0 from bit 7 to bit 8, expand the value to keep it negative.
-			else if (val_is_negative && (new_val.value[new_val.value.size() - 1] & (1 << (byte_bits - 2))) == 0)
-			{
-				new_val.value.push_back(UINT8_MAX);
-				new_val.size++;
-			}
+	LargeInt operator^(LargeInt&& other) const &
+	{
+		other.max_size = max_size;
+		other ^= *this;
 
-			new_val.value[new_val.value.size() - 1] <<= 1;
+		return std::move(other);
+	}
 
-			// Shift the rest of the bits
-			for (size_t i = new_val.value.size() - 2; i != SIZE_MAX; i--)
-			{
-				const bool carry = ((new_val.value[i] & (1 << (byte_bits - 1))) != 0);
-				if (carry)
-				{
-					new_val.value[i + 1] += 1;
-				}
-				new_val.value[i] <<= 1;
-			}
-		}
+	LargeInt operator^(LargeInt&& other) &&
+	{
+		*this ^= other;
+		return std::move(*this);
+	}
 
-		new_val.trim_size();
+	LargeInt& operator^=(const LargeInt& other)
+	{
+		bitwise_assign<bitwise_op::bit_xor>(other);
+		return *this;
+	}
+
+	LargeInt operator^(const LargeIntView& other) const
+	{
+		LargeInt new_val = *this;
+		new_val ^= other;
 
 		return new_val;
 	}
 
+	LargeInt& operator^=(const LargeIntView& other)
+	{
+		bitwise_assign<bitwise_op::bit_xor>(other);
+		return *this;
+	}
+
+	// Left shifts the number by the specified amount of bits
 	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
-	LargeInt& operator<<=(Integer other)
+	LargeInt operator<<(const Integer& other) const &
 	{
-		*this = *this << other;
+		LargeInt new_val = *this;
+		new_val <<= other;
 
-		return *this;
+		return new_val;
+	}
+
+	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+	LargeInt operator<<(Integer other) &&
+	{
+		*this <<= other;
+		return std::move(*this);
 	}
 
-	// Right shifts the number by the specified amount of bits
 	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
-	LargeInt operator>>(Integer other) const
+	LargeInt& operator<<=(Integer other)
 	{
 		// If a negative number was given, do the opposite bit shift operation.
 		if constexpr (std::is_signed<Integer>::value)
 		{
 			if (other < 0)
 			{
-				return *this >> -other;
-			}
-		}
-
-		size_t other_size = static_cast<size_t>(other);
-		LargeInt new_val = *this;
-		const bool val_is_negative = new_val.is_negative();
-
-		// If the number of shifts is larger than the amount of bits,
-		// return a value of 0 if positive or -1 if negative.
-		if (other_size >= new_val.size * byte_bits)
-		{
-			if (val_is_negative)
-			{
-				new_val.value.clear();
-				new_val.value.push_back(UINT8_MAX);
-			}
-			else
-			{
-				new_val.value.clear();
-				new_val.value.push_back(0);
+				shift_right(size_t(0) - static_cast<size_t>(other));
+				return *this;
 			}
-			new_val.size = 1;
-			return new_val;
-		}
-
-		// For multiples of 8 bits, simply remove a byte from the beginning.
-		for (; other_size >= byte_bits; other_size -= byte_bits)
-		{
-			new_val.value.erase(new_val.value.begin());
-			new_val.size--;
 		}
 
-		for (; other_size > 0; other_size--)
-		{
-			new_val.value[0] >>= 1;
-
-			for (size_t i = 1; i < new_val.value.size(); i++)
-			{
-				if ((new_val.value[i] & 1) != 0)
-				{
-					new_val.value[i - 1] += (1 << (byte_bits - 1));
-				}
-				new_val.value[i] >>= 1;
-			}
+		shift_left(static_cast<size_t>(other));
 
-			// If the value is negative, make sure it remains negative.
-			if (val_is_negative)
-			{
-				new_val.value[new_val.value.size() - 1] |= (1 << (byte_bits - 1));
-			}
-		}
+		return *this;
+	}
 
-		new_val.recalculate_size();
+	// Right shifts the number by the specified amount of bits
+	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+	LargeInt operator>>(Integer other) const &
+	{
+		LargeInt new_val = *this;
+		new_val >>= other;
 
 		return new_val;
 	}
 
+	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+	LargeInt operator>>(Integer other) &&
+	{
+		*this >>= other;
+		return std::move(*this);
+	}
+
 	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
 	LargeInt& operator>>=(Integer other)
 	{
-		*this = *this >> other;
+		// If a negative number was given, do the opposite bit shift operation.
+		if constexpr (std::is_signed<Integer>::value)
+		{
+			if (other < 0)
+			{
+				shift_left(size_t(0) - static_cast<size_t>(other));
+				return *this;
+			}
+		}
+
+		shift_right(static_cast<size_t>(other));
 
 		return *this;
 	}
@@ -905,18 +902,20 @@ public:
 	}
 
 	// Bitwise negates the number.
-	LargeInt operator~() const
+	LargeInt operator~() const &
 	{
 		LargeInt new_val = *this;
-
-		for (auto& iter : new_val.value)
-		{
-			iter = ~iter;
-		}
+		bytes_invert(new_val.value.data(), new_val.value.size());
 
 		return new_val;
 	}
 
+	LargeInt operator~() &&
+	{
+		bytes_invert(value.data(), value.size());
+		return std::move(*this);
+	}
+
 	// Compares two numbers and returns the relevant ordering constant.
 	// Uses weak ordering as substitutability is not guaranteed due to max size possibly differing.
 	// Use is_exactly_equal() if you want to guarantee substitutability.
@@ -931,13 +930,10 @@ public:
 			return std::weak_ordering::less;
 		}
 
-		if (size > other.size)
-		{
-			return std::weak_ordering::greater;
-		}
-		else if (size < other.size)
+		// Both have the same sign here, and a longer negative number is further from 0.
+		if (size != other.size)
 		{
-			return std::weak_ordering::less;
+			return (is_negative() ? other.size <=> size : size <=> other.size);
 		}
 
 		for (size_t i = value.size() - 1; i != SIZE_MAX; i--)
@@ -981,6 +977,23 @@ public:
 		return true;
 	}
 
+	// Compares against a viewed number without copying either of them.
+	std::weak_ordering operator<=>(const LargeIntView& other) const noexcept
+	{
+		if (is_negative() != other.is_negative())
+		{
+			return (is_negative() ? std::weak_ordering::less : std::weak_ordering::greater);
+		}
+
+		const std::weak_ordering magnitude = compare_magnitude(other.get_limbs());
+		return (is_negative() ? 0 <=> magnitude : magnitude);
+	}
+
+	bool operator==(const LargeIntView& other) const noexcept
+	{
+		return is_negative() == other.is_negative() && compare_magnitude(other.get_limbs()) == 0;
+	}
+
 	// Checks if the given size would be larger than the max size of the number.
 	bool too_large(size_t new_size) const noexcept
 	{
@@ -1018,200 +1031,5750 @@ public:
 		return (is_negative() ? -(*this) : *this);
 	}
 
-	// Returns true if the two numbers have an equal value AND max size.
-	bool is_exactly_equal(const LargeInt& other) const noexcept
-	{
-		if (max_size != other.max_size)
-		{
-			return false;
-		}
+	// All of the bit queries below treat the number as an infinitely sign extended two's complement value,
+	// the same way the bitwise operators do. Bit 0 is the least significant bit.
 
-		return *this == other;
+	// Get the number of bits needed to hold the value, not counting the sign bit.
+	// 0 and -1 have a bit length of 0, 255 and -256 have a bit length of 8.
+	size_t bit_length() const noexcept
+	{
+		// The value is always trimmed, so only the top byte needs looking at.
+		const uint8_t top = value[value.size() - 1];
+		return (value.size() - 1) * byte_bits + std::bit_width(static_cast<uint8_t>(is_negative() ? ~top : top));
 	}
 
-	inline friend std::ostream& operator<<(std::ostream& out, const LargeInt& num);
-
-	// Boolean cast operator
-	explicit operator bool() const noexcept
+	// Get the number of bits that are different from the sign bit.
+	// For positive numbers that's the number of 1s and for negative numbers it's the number of 0s.
+	size_t popcount() const noexcept
 	{
-		return size > 1 || value[0] != 0;
+		const size_t ones = bytes_popcount(value.data(), value.size());
+		return (is_negative() ? value.size() * byte_bits - ones : ones);
 	}
 
-	// Integer cast operator
-	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
-	explicit operator Integer() const noexcept
+	// Get the number of trailing 0 bits, i.e the index of the lowest 1 bit.
+	// Returns SIZE_MAX for 0, which has no 1 bits at all.
+	size_t countr_zero() const noexcept
 	{
-		Integer num = 0;
-
-		for (size_t i = 0; i < sizeof(Integer) && (i < size || is_negative()); i++)
+		for (size_t i = 0; i < value.size(); i++)
 		{
-			if (i < size)
-			{
-				num += value[i] << byte_bits * i;
-			}
-			else
+			if (value[i] != 0)
 			{
-				num += UINT8_MAX << byte_bits * i;
+				return i * byte_bits + std::countr_zero(value[i]);
 			}
 		}
 
-		return num;
+		return SIZE_MAX;
 	}
 
-	// Floating point cast operator
-	template<typename FloatingPoint, std::enable_if_t<std::is_floating_point<FloatingPoint>::value, bool> = true>
-	explicit operator FloatingPoint() const
+	// Get whether the given bit is 1.
+	bool test_bit(size_t bit) const noexcept
 	{
-		FloatingPoint num = 0;
-
-		const bool val_is_negative = is_negative();
-		LargeInt abs_val = LargeInt(*this, 0).abs();
-
-		if (abs_val.size > 2 && (abs_val.size - 2) * byte_bits > std::numeric_limits<FloatingPoint>::max_exponent)
+		if (bit / byte_bits >= value.size())
 		{
-			return std::numeric_limits<FloatingPoint>::infinity() * static_cast<FloatingPoint>(val_is_negative ? -1.0 : 1.0);
+			return is_negative();
 		}
 
-		for (size_t i = abs_val.size - 1; i != SIZE_MAX && num >= std::numeric_limits<FloatingPoint>::lowest() && num <= std::numeric_limits<FloatingPoint>::max(); i--)
+		return (value[bit / byte_bits] & (1 << (bit % byte_bits))) != 0;
+	}
+
+	// Sets the given bit to 1 in place.
+	// If the bit would be past the max size, the number doesn't change.
+	LargeInt& set_bit(size_t bit)
+	{
+		if (!test_bit(bit))
 		{
-			if (abs_val.value[i] != 0)
-			{
-				num += static_cast<FloatingPoint>(abs_val.value[i] * pow(2, byte_bits * i));
-			}
+			flip_bit(bit);
 		}
 
-		return num * static_cast<FloatingPoint>(val_is_negative ? -1.0 : 1.0);
+		return *this;
 	}
 
-	// String cast operator
-	// Converts the number to bcd and then appends every byte in hex to a string.
-	explicit operator std::string() const
+	// Sets the given bit to 0 in place.
+	// If the bit would be past the max size, the number doesn't change.
+	LargeInt& clear_bit(size_t bit)
 	{
-		auto [bcd_num, sign] = this->convert_to_bcd();
-
-		std::string output = (sign < 0 ? "-" : "") + std::format("{:x}", *bcd_num.value.rbegin());
-
-		for (auto byte = bcd_num.value.rbegin() + 1; byte != bcd_num.value.rend(); byte++)
+		if (test_bit(bit))
 		{
-			if (byte != bcd_num.value.rbegin())
+			flip_bit(bit);
+		}
+
+		return *this;
+	}
+
+	// Flips the given bit in place.
+	// If the bit would be past the max size, the number doesn't change.
+	LargeInt& flip_bit(size_t bit)
+	{
+		const size_t index = bit / byte_bits;
+
+		if (too_large(index + 1))
+		{
+			return *this;
+		}
+
+		// Make sure there's a sign extended byte above the one being changed so the sign can't flip by accident.
+		if (index + 1 >= value.size())
+		{
+			value.resize(index + 2, is_negative() ? UINT8_MAX : 0);
+		}
+
+		value[index] ^= static_cast<uint8_t>(1 << (bit % byte_bits));
+
+		trim_size();
+		return *this;
+	}
+
+	// Returns true if the two numbers have an equal value AND max size.
+	bool is_exactly_equal(const LargeInt& other) const noexcept
+	{
+		if (max_size != other.max_size)
+		{
+			return false;
+		}
+
+		return *this == other;
+	}
+
+	// Returns the greatest common divisor of two numbers. The result is never negative and gcd(0, 0) is 0.
+	// Small numbers use a binary gcd, bigger ones use Lehmer's algorithm and really big ones a half-gcd reduction.
+	// The result has the max size of the left-hand side.
+	static LargeInt gcd(const LargeInt& a, const LargeInt& b)
+	{
+		return from_limbs(mag_gcd(a.to_limbs(), b.to_limbs(), nullptr), false, a.max_size);
+	}
+
+	// Returns the least common multiple of two numbers. The result is never negative and lcm(x, 0) is 0.
+	// The result has the max size of the left-hand side.
+	static LargeInt lcm(const LargeInt& a, const LargeInt& b)
+	{
+		const limb_vector abs_a = a.to_limbs();
+		const limb_vector abs_b = b.to_limbs();
+
+		if (abs_a.empty() || abs_b.empty())
+		{
+			return LargeInt(0, a.max_size);
+		}
+
+		// Divide before multiplying so the product is as small as it can be
+		const limb_vector divisor = mag_gcd(abs_a, abs_b, nullptr);
+		return from_limbs(mag_mul(mag_divmod(abs_a, divisor, nullptr), abs_b), false, a.max_size);
+	}
+
+	// Extended gcd. Returns { g, s, t } such that s * a + t * b == g, where g == gcd(a, b).
+	// All three values have the max size of the left-hand side.
+	static std::tuple<LargeInt, LargeInt, LargeInt> gcdext(const LargeInt& a, const LargeInt& b)
+	{
+		// The reduction matrix ends up as (|a|; |b|) = M * (g; 0), so g = det(M) * (m11 * |a| - m01 * |b|).
+		gcd_matrix matrix;
+		limb_vector result = mag_gcd(a.to_limbs(), b.to_limbs(), &matrix);
+
+		LargeInt s = from_limbs(std::move(matrix.entry[1][1]), matrix.odd != a.is_negative(), a.max_size);
+		LargeInt t = from_limbs(std::move(matrix.entry[0][1]), matrix.odd == b.is_negative(), a.max_size);
+
+		return std::make_tuple(from_limbs(std::move(result), false, a.max_size), std::move(s), std::move(t));
+	}
+
+	// Returns the inverse of a modulo m, in the range [0, |m|).
+	// Throws div_by_zero if m is 0 and not_invertible if a and m aren't coprime.
+	// The result has the max size of the left-hand side.
+	static LargeInt invert(const LargeInt& a, const LargeInt& m)
+	{
+		const limb_vector modulus = m.to_limbs();
+
+		if (modulus.empty())
+		{
+			// oopsies :3
+			throw div_by_zero("LargeInt modular inverse with a modulus of zero.");
+		}
+
+		// Reduce first so the gcd starts out with two similarly sized numbers
+		limb_vector residue;
+		mag_divmod(a.to_limbs(), modulus, &residue);
+
+		if (a.is_negative() && !residue.empty())
+		{
+			residue = mag_sub(modulus, residue);
+		}
+
+		// (m; r) = M * (g; 0), so g == det(M) * (m11 * m - m01 * r) == -det(M) * m01 * r (mod m)
+		gcd_matrix matrix;
+		const limb_vector result = mag_gcd(modulus, residue, &matrix);
+
+		if (result.size() != 1 || result[0] != 1)
+		{
+			throw not_invertible("LargeInt modular inverse of a number that isn't coprime with the modulus.");
+		}
+
+		limb_vector inverse = std::move(matrix.entry[0][1]);
+		mag_divmod(limb_vector(inverse), modulus, &inverse);
+
+		if (!matrix.odd && !inverse.empty())
+		{
+			inverse = mag_sub(modulus, inverse);
+		}
+
+		return from_limbs(std::move(inverse), false, a.max_size);
+	}
+
+	// Returns n!.
+	// The odd parts are multiplied together in balanced product trees and the power of two is applied with a single shift at the end.
+	static LargeInt factorial(uint64_t n)
+	{
+		// n! has n - popcount(n) factors of two (Legendre)
+		limb_vector result = mag_odd_factorial(n);
+		mag_shift_left(result, n - std::popcount(n));
+
+		return from_limbs(std::move(result), false, 0);
+	}
+
+	// Returns the binomial coefficient n choose k, which is 0 if k > n.
+	// n * (n - 1) * ... * (n - k + 1) is built with a product tree and then divided exactly by the odd part of k!.
+	static LargeInt binomial(uint64_t n, uint64_t k)
+	{
+		if (k > n)
+		{
+			return LargeInt(0);
+		}
+
+		k = std::min(k, n - k);
+
+		if (k == 0)
+		{
+			return LargeInt(1);
+		}
+
+		// Everything that's left after dividing out the odd part is a power of two (Kummer: one for every carry when adding k and n - k)
+		limb_vector result = mag_range_product(n - k + 1, k, 1);
+		mag_shift_right(result, mag_countr_zero(result));
+		result = mag_divexact(result, mag_odd_factorial(k));
+		mag_shift_left(result, std::popcount(k) + std::popcount(n - k) - std::popcount(n));
+
+		return from_limbs(std::move(result), false, 0);
+	}
+
+	// Returns the nth Fibonacci number, F(0) = 0, F(1) = 1.
+	static LargeInt fibonacci(uint64_t n)
+	{
+		limb_vector f, g;
+		mag_fibonacci(n, f, g);
+
+		return from_limbs(std::move(f), false, 0);
+	}
+
+	// Returns the nth Lucas number, L(0) = 2, L(1) = 1.
+	static LargeInt lucas(uint64_t n)
+	{
+		// L(n) = 2 * F(n + 1) - F(n)
+		limb_vector f, g;
+		mag_fibonacci(n, f, g);
+		mag_shift_left(g, 1);
+
+		return from_limbs(mag_sub(g, f), false, 0);
+	}
+
+	// Returns the product of everything in the range, which can hold LargeInts or built-in integers. The product of nothing is 1.
+	// The factors are multiplied in a balanced tree (see mag_product()), so the big multiplications near the top are between numbers
+	// of about the same size, which Karatsuba is good at, instead of one ever growing number times a small one each time.
+	// Built-in integers get packed a limb's worth at a time before going into the tree.
+	template<typename Range>
+	static LargeInt product(const Range& range)
+	{
+		using term_type = std::remove_cvref_t<decltype(*std::begin(range))>;
+		static_assert(std::is_integral<term_type>::value || std::is_same<term_type, LargeInt>::value, "LargeInt::product() needs a range of LargeInts or integers.");
+
+		std::vector<limb_vector> factors;
+		limb_t packed = 1;
+		bool negative = false;
+
+		for (const auto& factor : range)
+		{
+			if constexpr (std::is_integral<term_type>::value)
+			{
+				const limb_t magnitude = word_magnitude(factor);
+
+				if (magnitude == 0)
+				{
+					return LargeInt(0);
+				}
+
+				limb_t high;
+				const limb_t low = mul_wide(packed, magnitude, high);
+
+				if (high != 0)
+				{
+					factors.push_back({ packed });
+					packed = magnitude;
+				}
+				else
+				{
+					packed = low;
+				}
+
+				negative = negative != word_is_negative(factor);
+			}
+			else
 			{
-				// Make sure there's padding of 2 zeros because this doesn't give leading zeros.
-				output += std::format("{:02x}", *byte);
+				if (factor == 0)
+				{
+					return LargeInt(0);
+				}
+
+				factors.push_back(factor.to_limbs());
+				negative = negative != factor.is_negative();
 			}
 		}
 
-		return output;
+		factors.push_back({ packed });
+		return from_limbs(mag_product(factors, 0, factors.size()), negative, 0);
 	}
 
-protected:
-	std::vector<uint8_t> value;
-	size_t size;
-	size_t max_size;
+	// Returns the sum of everything in the range, which can hold LargeInts or built-in integers. The sum of nothing is 0.
+	// Every term is added into columns of limbs without carrying between them (see column_sum), so the carries are only propagated once,
+	// at the very end. If the range can be gone through more than once, the columns are sized for the longest term up front.
+	template<typename Range>
+	static LargeInt sum(const Range& range)
+	{
+		using term_type = std::remove_cvref_t<decltype(*std::begin(range))>;
+		static_assert(std::is_integral<term_type>::value || std::is_same<term_type, LargeInt>::value, "LargeInt::sum() needs a range of LargeInts or integers.");
 
-	const static uint8_t byte_bits = 8;
+		// Positive and negative terms are summed apart and only subtracted at the end.
+		column_sum positive;
+		column_sum negative;
+		limb_vector scratch;
 
-	// Trim the number if it's above the maximum size.
-	void trim_size()
+		if constexpr (std::forward_iterator<decltype(std::begin(range))>)
+		{
+			size_t longest = 1;
+
+			if constexpr (!std::is_integral<term_type>::value)
+			{
+				for (const auto& term : range)
+				{
+					longest = std::max(longest, (term.value.size() + limb_bytes - 1) / limb_bytes);
+				}
+			}
+
+			positive.reserve(longest);
+			negative.reserve(longest);
+			scratch.resize(longest);
+		}
+
+		for (const auto& term : range)
+		{
+			if constexpr (std::is_integral<term_type>::value)
+			{
+				const limb_t magnitude = word_magnitude(term);
+				(word_is_negative(term) ? negative : positive).add(&magnitude, 1);
+			}
+			else
+			{
+				scratch.resize(std::max(scratch.size(), (term.value.size() + limb_bytes - 1) / limb_bytes));
+				const size_t n = term.copy_limbs(scratch.data());
+				(term.is_negative() ? negative : positive).add(scratch.data(), n);
+			}
+		}
+
+		bool result_negative;
+		limb_vector result = mag_sub_signed(positive.finish(), negative.finish(), result_negative);
+
+		return from_limbs(std::move(result), result_negative, 0);
+	}
+
+	// Miller-Rabin primality test. Returns false for anything that isn't a positive prime, and true for primes
+	// or (with a chance of at most 4^-rounds, whoever picked the number) composites that fooled every round.
+	// The bases are drawn from a generator per thread seeded by std::random_device, pass a generator to the other overload to pick them yourself.
+	// Numbers that fit in 64 bits always get the right answer, rounds is ignored for them.
+	bool is_probable_prime(size_t rounds = 25) const
 	{
-		recalculate_size();
+		static thread_local std::mt19937_64 urbg = []()
+		{
+			std::random_device device;
+			std::seed_seq seed{ device(), device(), device(), device(), device(), device(), device(), device() };
+			return std::mt19937_64(seed);
+		}();
 
-		if (!too_large(size))
+		return is_probable_prime(rounds, urbg);
+	}
+
+	// Miller-Rabin primality test with bases drawn uniformly from [2, n - 2] by the given generator.
+	// The 4^-rounds bound only holds if the generator's output can't be predicted by whoever picked the number.
+	template<typename URBG>
+	bool is_probable_prime(size_t rounds, URBG&& urbg) const
+	{
+		if (is_negative())
 		{
-			return;
+			return false;
 		}
 
-		while (too_large(size))
+		const limb_vector n = to_limbs();
+		const std::optional<bool> small_result = mag_trial_division(n);
+
+		if (small_result.has_value())
 		{
-			value.pop_back();
-			size--;
+			return *small_result;
+		}
+
+		const montgomery_context context(n);
+
+		if (n.size() == 1)
+		{
+			// These bases are enough to be exact below 3.3 * 10^24 (Sorenson & Webster)
+			for (limb_t base : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 })
+			{
+				if (!mag_strong_probable_prime(context, { base }))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		// n has at least two limbs here, so n - 3 can't be zero.
+		const limb_vector base_range = mag_sub(n, { 3 });
+
+		for (size_t round = 0; round < rounds; round++)
+		{
+			if (!mag_strong_probable_prime(context, mag_add(mag_random_below(base_range, urbg), { 2 })))
+			{
+				return false;
+			}
 		}
+
+		return true;
 	}
 
-	// Trims unnecessary 0 and 255 bytes and recalculates the number's size.
-	void recalculate_size()
+	// Baillie-PSW primality test: a strong probable prime test to base 2 followed by a strong Lucas probable prime test.
+	// There's no known composite that passes it, and it's known to be exact below 2^64.
+	// Returns false for anything that isn't a positive prime.
+	bool is_probable_prime_bpsw() const
 	{
-		if (value.size() < 1)
+		if (is_negative())
 		{
-			value.push_back(0);
+			return false;
 		}
 
-		// If there's a leading 0 byte and the following byte does not have bit 8 set to 1, trim the byte.
-		// If there's a leading 255 byte and the following byte does not have bit 8 set to 0, trim the byte.
-		// Neither of these should change the actual value of the number.
-		while (value.size() > 1
-			   && ((*value.rbegin() == 0 && (*(value.rbegin() + 1) & (1 << (byte_bits - 1))) == 0)
-				   || (*value.rbegin() == UINT8_MAX && (*(value.rbegin() + 1) & (1 << (byte_bits - 1))) != 0)))
+		const limb_vector n = to_limbs();
+		const std::optional<bool> small_result = mag_trial_division(n);
+
+		if (small_result.has_value())
 		{
-			value.pop_back();
+			return *small_result;
 		}
 
-		size = value.size();
+		return mag_bpsw(n);
 	}
 
-	// Converts the number to binary coded decimal and returns it
-	// along with +1 or -1 to signify if it's negative or positive.
-	// This is the only case where LargeInt is treated as unsigned.
-	std::pair<LargeInt, int8_t> convert_to_bcd() const
+	// Returns the smallest prime larger than n (as decided by the BPSW test).
+	// Candidates are sieved by the small primes a window at a time, so most of them never get near a modular exponentiation.
+	// The result has the max size of n.
+	static LargeInt next_prime(const LargeInt& n)
 	{
-		const bool val_is_negative = this->is_negative();
-		const LargeInt abs_val = LargeInt(*this, 0).abs();
-		LargeInt new_val = 0;
+		if (n < LargeInt(2))
+		{
+			return LargeInt(2, n.max_size);
+		}
+
+		// Start at the first odd number after n
+		limb_vector start = mag_add(n.to_limbs(), { 1 });
+		start = mag_add(start, { start[0] & 1 ? limb_t(0) : limb_t(1) });
+
+		const std::vector<limb_t>& primes = small_primes();
 
-		for (auto byte = abs_val.value.rbegin(); byte != abs_val.value.rend(); byte++)
+		if (start.size() == 1 && start[0] <= primes.back())
 		{
-			#ifdef _MSC_VER
-			#pragma warning(suppress : 6293)	// shut the fuck up :3
-			#endif
-			for (uint8_t bit = byte_bits - 1; bit != UINT8_MAX; bit--)
+			return LargeInt(*std::lower_bound(primes.begin(), primes.end(), start[0]), n.max_size);
+		}
+
+		// Prime gaps average about ln(n), make the window a few times that.
+		const size_t window = std::max<size_t>(mag_bit_length(start), 64);
+		std::vector<bool> composite;
+
+		while (true)
+		{
+			// composite[i] is about start + 2 * i
+			composite.assign(window, false);
+
+			mag_small_prime_residues(start, [&](limb_t prime, limb_t residue)
 			{
-				for (auto val = new_val.value.rbegin(); val != new_val.value.rend(); val++)
+				// start + 2 * i == 0 (mod p) when i == -residue / 2 (mod p)
+				for (limb_t i = (prime - residue) % prime * ((prime + 1) / 2) % prime; i < window; i += prime)
 				{
-					// If the top half of the byte is >4, add 3 to it.
-					if ((*val >> 4) > 4)
-					{
-						*val += 3 << 4;
+					composite[i] = true;
+				}
 
-						// If it's the last byte, also expand the number.
-						// Resets the iterator as push_back invalidates it.
-						if (val == new_val.value.rbegin())
-						{
-							new_val.value.push_back(0);
-							val = new_val.value.rbegin() + 1;
-						}
-					}
+				return true;
+			});
 
-					// If the bottom half of the byte is >4, add 3 to it.
-					if ((*val & (UINT8_MAX >> 4)) > 4)
-					{
-						*val += 3;
-					}
+			for (size_t i = 0; i < window; i++)
+			{
+				if (composite[i])
+				{
+					continue;
 				}
 
-				// Shift the value to the left and add the next bit (from the left) from the original value.
-				new_val <<= 1;
-				if (*byte & (1 << bit))
+				limb_vector candidate = mag_add(start, { 2 * static_cast<limb_t>(i) });
+
+				// Anything below the square of the sieving limit that survived the sieve is prime.
+				if ((candidate.size() == 1 && candidate[0] < small_prime_limit * small_prime_limit) || mag_bpsw(candidate))
 				{
-					new_val.value[0] += 1;
+					return from_limbs(std::move(candidate), false, n.max_size);
 				}
 			}
+
+			start = mag_add(start, { 2 * static_cast<limb_t>(window) });
 		}
+	}
+
+	// Returns a uniformly distributed random number in [0, 2^bits), straight from the generator a limb at a time.
+	template<typename URBG>
+	static LargeInt random_bits(size_t bits, URBG&& urbg)
+	{
+		limb_vector limbs((bits + limb_bits - 1) / limb_bits);
 
-		new_val.recalculate_size();
+		for (limb_t& limb : limbs)
+		{
+			limb = random_limb(urbg);
+		}
 
-		// Unlike every other case, this number is ALWAYS UNSIGNED and as such leading 0s need to be removed.
-		// Whether the number is positive or negative is returned as a +1 or -1 in a pair with the number.
-		if (new_val.value[new_val.size - 1] == 0 && new_val.size > 1)
+		if (bits % limb_bits != 0)
 		{
-			new_val.value.pop_back();
+			limbs.back() &= (limb_t(1) << (bits % limb_bits)) - 1;
 		}
 
-		return std::make_pair(new_val, static_cast<int8_t>(val_is_negative ? -1 : +1));
+		mag_normalize(limbs);
+		return from_limbs(std::move(limbs), false, 0);
 	}
-};
 
-std::ostream& operator<<(std::ostream& out, const LargeInt& num)
-{
-	out << static_cast<std::string>(num);
+	// Returns a uniformly distributed random number in [0, bound).
+	// Throws std::invalid_argument if the bound isn't positive.
+	// The result has the max size of the bound.
+	template<typename URBG>
+	static LargeInt random_below(const LargeInt& bound, URBG&& urbg)
+	{
+		const limb_vector limit = bound.to_limbs();
 
-	return out;
-}
+		if (limit.empty() || bound.is_negative())
+		{
+			throw std::invalid_argument("LargeInt random number below a bound that isn't positive.");
+		}
+
+		return from_limbs(mag_random_below(limit, urbg), false, bound.max_size);
+	}
+
+	// Parses a string of digits in any base from 2 to 36, optionally starting with a + or -. Letters are case insensitive.
+	// Throws invalid_string_conversion if there are no digits or a character isn't a digit in the base, and std::invalid_argument for a bad base.
+	// Chunks of digits are read straight into limbs, then glued together pairwise using powers of the base that get squared as they go up,
+	// which keeps it subquadratic. Power of two bases skip all that and drop the digits' bits straight into place.
+	static LargeInt from_string(std::string_view str, int base = 10)
+	{
+		if (base < 2 || base > 36)
+		{
+			throw std::invalid_argument("LargeInt string conversion with a base that isn't between 2 and 36.");
+		}
+
+		bool negative = false;
+
+		if (!str.empty() && (str[0] == '-' || str[0] == '+'))
+		{
+			negative = (str[0] == '-');
+			str.remove_prefix(1);
+		}
+
+		if (str.empty())
+		{
+			throw invalid_string_conversion("Cannot convert a string without any digits to LargeInt.");
+		}
+
+		return from_limbs(mag_from_digits(str, static_cast<limb_t>(base)), negative, 0);
+	}
+
+	// Compact binary encoding. Everything starts with a LEB128 varint header h:
+	// - If bit 0 of h is 0, the number is small (|num| < 2^62) and is h >> 1 zigzag encoded (0, -1, 1, -2, ... become 0, 1, 2, 3, ...).
+	// - Otherwise h >> 1 is (limb count << 1) | sign, followed by the magnitude as that many little endian 64 bit limbs.
+	// So -32 to 31 take a single byte and nothing ever needs a separate length field.
+
+	// Number of bytes serialize() writes.
+	size_t serialized_size() const noexcept
+	{
+		const size_t bits = magnitude_bit_length();
+
+		if (bits <= wire_small_bits)
+		{
+			return varint_size(wire_small_header());
+		}
+
+		const size_t limbs = (bits + limb_bits - 1) / limb_bits;
+		return varint_size(wire_large_header(limbs)) + limbs * limb_bytes;
+	}
+
+	// Writes the number to an output iterator of bytes and returns the iterator past the end.
+	// Reads straight out of the stored bytes, nothing gets copied on the way.
+	template<typename OutputIt>
+	OutputIt serialize(OutputIt out) const
+	{
+		const size_t bits = magnitude_bit_length();
+
+		if (bits <= wire_small_bits)
+		{
+			return write_varint(out, wire_small_header());
+		}
+
+		const size_t limbs = (bits + limb_bits - 1) / limb_bits;
+		out = write_varint(out, wire_large_header(limbs));
+
+		return write_magnitude_bytes(out, limbs * limb_bytes);
+	}
+
+	// Reads one serialized number off the front of data and moves data past it.
+	// Throws invalid_serialization if data doesn't start with a whole serialized number.
+	static LargeInt deserialize(std::span<const uint8_t>& data)
+	{
+		const uint64_t header = read_varint(data);
+
+		if ((header & 1) == 0)
+		{
+			const uint64_t zigzag = header >> 1;
+			return LargeInt(static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1));
+		}
+
+		const bool negative = ((header >> 1) & 1) != 0;
+		const uint64_t limbs = header >> 2;
+
+		if (limbs > data.size() / limb_bytes)
+		{
+			throw invalid_serialization("Serialized LargeInt is cut off.");
+		}
+
+		const size_t bytes = static_cast<size_t>(limbs) * limb_bytes;
+		LargeInt new_val = from_magnitude_bytes(data.data(), bytes, negative);
+		data = data.subspan(bytes);
+
+		return new_val;
+	}
+
+	// Appends a whole range of numbers to a byte buffer. The buffer is resized once up front and then written to without any more checks.
+	template<typename Range>
+	static void serialize_all(const Range& nums, std::vector<uint8_t>& out)
+	{
+		size_t total = 0;
+
+		for (const LargeInt& num : nums)
+		{
+			total += num.serialized_size();
+		}
+
+		const size_t start = out.size();
+		out.resize(start + total);
+		uint8_t* position = out.data() + start;
+
+		for (const LargeInt& num : nums)
+		{
+			position = num.serialize(position);
+		}
+	}
+
+	// Reads numbers until data runs out. Throws invalid_serialization if the last one is cut off.
+	static std::vector<LargeInt> deserialize_all(std::span<const uint8_t> data)
+	{
+		std::vector<LargeInt> nums;
+
+		while (!data.empty())
+		{
+			nums.push_back(deserialize(data));
+		}
+
+		return nums;
+	}
+
+	// Raw import and export of the magnitude as an array of fixed size words, like GMP's mpz_import and mpz_export.
+	// Words always go least significant first, endianness is the byte order inside each word. The sign is kept separately.
+	// Little endian words are already the same layout as the storage so they're a single memcpy, big endian ones get byte swapped in place after.
+
+	// Builds a number out of data.size() / word_size words and a sign.
+	// Throws std::invalid_argument if word_size is 0 or data isn't a whole number of words.
+	static LargeInt import_bits(std::span<const uint8_t> data, size_t word_size, std::endian endianness, bool negative = false)
+	{
+		if (word_size == 0 || data.size() % word_size != 0)
+		{
+			throw std::invalid_argument("LargeInt import from data that isn't a whole number of words.");
+		}
+
+		// One extra byte for the sign bit, then negated in place if it needs to be.
+		LargeInt new_val;
+		new_val.value.resize(data.size() + 1);
+
+		if (!data.empty())
+		{
+			std::memcpy(new_val.value.data(), data.data(), data.size());
+		}
+
+		if (endianness != std::endian::little)
+		{
+			bytes_reverse_words(new_val.value.data(), data.size(), word_size);
+		}
+
+		if (negative)
+		{
+			bytes_negate(new_val.value.data(), new_val.value.size());
+		}
+
+		new_val.trim_size();
+		return new_val;
+	}
+
+	// Same as above for an array of native unsigned integers.
+	template<typename Word, std::enable_if_t<std::is_integral<Word>::value && std::is_unsigned<Word>::value, bool> = true>
+	static LargeInt import_bits(std::span<const Word> words, bool negative = false)
+	{
+		return import_bits(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(words.data()), words.size_bytes()), sizeof(Word), std::endian::native, negative);
+	}
+
+	// Number of word_size byte words export_bits() writes. 0 has no words at all.
+	size_t export_size(size_t word_size) const noexcept
+	{
+		const size_t word_bits = word_size * byte_bits;
+		return (word_size == 0 ? 0 : (magnitude_bit_length() + word_bits - 1) / word_bits);
+	}
+
+	// Writes the magnitude as export_size(word_size) words to the start of out and returns how many words that was. Anything after them isn't touched.
+	// Throws std::invalid_argument if word_size is 0 or out is too small.
+	size_t export_bits(std::span<uint8_t> out, size_t word_size, std::endian endianness) const
+	{
+		if (word_size == 0)
+		{
+			throw std::invalid_argument("LargeInt export with a word size of 0.");
+		}
+
+		const size_t words = export_size(word_size);
+		const size_t bytes = words * word_size;
+
+		if (out.size() < bytes)
+		{
+			throw std::invalid_argument("LargeInt export to a buffer that's too small.");
+		}
+
+		// Copy the two's complement bytes, sign extended, and negate them in place if needed.
+		// The magnitude fits in bytes, so negating modulo 2^(8 * bytes) gives it exactly.
+		const size_t copied = std::min(bytes, value.size());
+
+		if (copied > 0)
+		{
+			std::memcpy(out.data(), value.data(), copied);
+		}
+
+		std::fill(out.begin() + copied, out.begin() + bytes, is_negative() ? UINT8_MAX : 0);
+
+		if (is_negative())
+		{
+			bytes_negate(out.data(), bytes);
+		}
+
+		if (endianness != std::endian::little)
+		{
+			bytes_reverse_words(out.data(), bytes, word_size);
+		}
+
+		return words;
+	}
+
+	// Same as above into an array of native unsigned integers.
+	template<typename Word, std::enable_if_t<std::is_integral<Word>::value && std::is_unsigned<Word>::value, bool> = true>
+	size_t export_bits(std::span<Word> out) const
+	{
+		return export_bits(std::span<uint8_t>(reinterpret_cast<uint8_t*>(out.data()), out.size_bytes()), sizeof(Word), std::endian::native);
+	}
+
+	// Products where the smaller side has at least this many limbs (64 bits each) run their Karatsuba branches side by side.
+	const static size_t default_parallel_threshold = 2048;
+
+	// Spreads big multiplications over up to thread_budget threads, counting the one that's multiplying. Products where the smaller side
+	// has at least threshold limbs run their independent Karatsuba branches on threads of their own, splitting the budget between them,
+	// and so on down the recursion until the pieces get smaller than the threshold, where starting a thread costs more than it saves.
+	// The budget is the hardware's thread count to begin with, and a budget of 1 turns it off. Applies to every thread.
+	// There's no thread pool: the threads are started for the branches and joined after them. Splitting the budget means a multiplication
+	// never starts more than thread_budget - 1 of them, and at the default threshold each one has milliseconds of work to do, against
+	// the tens of microseconds it takes to start. If a branch throws (std::bad_alloc, say) it's rethrown on the multiplying thread.
+	static void set_parallel_multiplication(size_t threshold, unsigned int thread_budget) noexcept
+	{
+		parallel_threshold.store(threshold, std::memory_order_relaxed);
+		parallel_threads.store(std::max(thread_budget, 1u), std::memory_order_relaxed);
+	}
+
+	// Starts an expression template (see LargeIntExpr), so that something like LargeInt::lazy(a) * b + c - d gets evaluated in one go.
+	static LargeIntLeaf lazy(const LargeInt& num) noexcept;
+
+	// this += b * c, without making a LargeInt out of the product first. It's accumulated in place in this number's own bytes,
+	// so once they've grown big enough nothing gets allocated except a scratch product when both b and c take more than a limb.
+	// Truncated to the max size like everything else.
+	LargeInt& addmul(const LargeInt& b, const LargeInt& c)
+	{
+		return accumulate_product(b, c, false);
+	}
+
+	// this -= b * c, same as above.
+	LargeInt& submul(const LargeInt& b, const LargeInt& c)
+	{
+		return accumulate_product(b, c, true);
+	}
+
+	// this += b * c for a built-in integer c. It's a single limb, so the product is multiplied and added in one pass without allocating anything.
+	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+	LargeInt& addmul(const LargeInt& b, Integer c)
+	{
+		return accumulate_word_product(b, word_magnitude(c), word_is_negative(c));
+	}
+
+	// this -= b * c for a built-in integer c.
+	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+	LargeInt& submul(const LargeInt& b, Integer c)
+	{
+		return accumulate_word_product(b, word_magnitude(c), !word_is_negative(c));
+	}
+
+	inline friend std::ostream& operator<<(std::ostream& out, const LargeInt& num);
+	inline friend std::istream& operator>>(std::istream& in, LargeInt& num);
+	friend class ModInt;
+	friend class LargeIntFileReader;
+	friend class LargeIntFileWriter;
+	friend class LargeIntLeaf;
+	template<typename, typename, char>
+	friend class LargeIntExpr;
+	template<size_t>
+	friend class LargeIntConstant;
+	template<typename, typename> friend struct std::formatter;
+
+	// Boolean cast operator
+	explicit operator bool() const noexcept
+	{
+		return size > 1 || value[0] != 0;
+	}
+
+	// Integer cast operator
+	template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+	explicit operator Integer() const noexcept
+	{
+		Integer num = 0;
+
+		for (size_t i = 0; i < sizeof(Integer) && (i < size || is_negative()); i++)
+		{
+			if (i < size)
+			{
+				num += value[i] << byte_bits * i;
+			}
+			else
+			{
+				num += UINT8_MAX << byte_bits * i;
+			}
+		}
+
+		return num;
+	}
+
+	// Floating point cast operator
+	// Rounds to nearest (ties to even) and gives infinity if the number is too large. Only looks at the top two limbs' worth of bits,
+	// everything below that just decides whether the rounding is exactly halfway or not.
+	template<typename FloatingPoint, std::enable_if_t<std::is_floating_point<FloatingPoint>::value, bool> = true>
+	explicit operator FloatingPoint() const
+	{
+		constexpr size_t digits = std::numeric_limits<FloatingPoint>::digits;
+		static_assert(digits < 2 * limb_bits, "LargeInt float conversion needs the mantissa to fit in two limbs.");
+
+		const size_t bits = magnitude_bit_length();
+
+		if (bits == 0)
+		{
+			return 0;
+		}
+
+		// The top (up to) 128 bits of the magnitude, and whether anything below them is set.
+		// Negative numbers are the inverted bits plus 1, and that 1 only carries up this far if everything below is 0.
+		const bool val_is_negative = is_negative();
+		const size_t shift = (bits > 2 * limb_bits ? bits - 2 * limb_bits : 0);
+		const size_t lowest_one = countr_zero();
+		limb_t window[2] = { raw_bits_at(shift), raw_bits_at(shift + limb_bits) };
+		bool sticky = (lowest_one < shift);
+
+		if (val_is_negative)
+		{
+			window[0] = ~window[0];
+			window[1] = ~window[1];
+
+			if (!sticky && ++window[0] == 0)
+			{
+				window[1]++;
+			}
+		}
+
+		if (bits - shift < 2 * limb_bits)
+		{
+			// Everything above the magnitude is just sign extension.
+			const size_t top = bits - shift;
+			window[1] &= (top <= limb_bits ? 0 : ~limb_t(0) >> (2 * limb_bits - top));
+			window[0] &= (top >= limb_bits ? ~limb_t(0) : ~limb_t(0) >> (limb_bits - top));
+		}
+
+		// Cut the window down to the mantissa, rounding half to even on what's cut off.
+		const size_t discard = (bits - shift > digits ? bits - shift - digits : 0);
+
+		if (discard > 0)
+		{
+			const size_t round_bit = discard - 1;
+			const bool round = ((window[round_bit / limb_bits] >> (round_bit % limb_bits)) & 1) != 0;
+
+			const limb_t below_round = (round_bit % limb_bits == 0 ? 0 : window[round_bit / limb_bits] << (limb_bits - round_bit % limb_bits));
+			sticky = sticky || below_round != 0 || (round_bit >= limb_bits && window[0] != 0);
+
+			window[0] = (discard >= limb_bits ? window[1] >> (discard - limb_bits) : (window[0] >> discard) | (discard == 0 ? 0 : window[1] << (limb_bits - discard)));
+			window[1] = (discard >= limb_bits ? 0 : window[1] >> discard);
+
+			// Carrying into a new top bit gives 2^digits, which is still exact.
+			if (round && (sticky || (window[0] & 1) != 0) && ++window[0] == 0)
+			{
+				window[1]++;
+			}
+		}
+
+		// Both halves and their sum are exact, the only rounding was done above.
+		const FloatingPoint mantissa = std::ldexp(static_cast<FloatingPoint>(window[1]), static_cast<int>(limb_bits)) + static_cast<FloatingPoint>(window[0]);
+		const FloatingPoint num = std::ldexp(mantissa, static_cast<int>(std::min<size_t>(shift + discard, INT_MAX)));
+
+		return (val_is_negative ? -num : num);
+	}
+
+	// String cast operator
+	// Converts the number to decimal by splitting it in half by powers of 10^19 until the pieces fit in a few limbs.
+	explicit operator std::string() const
+	{
+		return mag_to_string(to_limbs(), 10, is_negative());
+	}
+
+	// Converts the number to a string of digits in any base from 2 to 36, with a minus in front if it's negative. Letters are lowercase.
+	// Throws std::invalid_argument for a bad base. Bases 2, 4, 8, 16 and 32 are just regrouping the bits, so they take linear time.
+	std::string to_string(int base = 10) const
+	{
+		if (base < 2 || base > 36)
+		{
+			throw std::invalid_argument("LargeInt string conversion with a base that isn't between 2 and 36.");
+		}
+
+		return mag_to_string(to_limbs(), static_cast<limb_t>(base), is_negative());
+	}
+
+	// Upper bound on how many characters to_chars() can need for this number in the base, sign included. Doesn't look at the digits.
+	size_t max_chars(int base = 10) const noexcept
+	{
+		if (base < 2 || base > 36)
+		{
+			return 0;
+		}
+
+		// Rounding the digits per bit up by a hair keeps floating point error from ever making it too small.
+		const double bits = static_cast<double>(value.size() * byte_bits);
+		return static_cast<size_t>(bits / std::log2(static_cast<double>(base)) * (1.0 + 1e-12)) + 2;
+	}
+
+	// Writes the number into [first, last) like std::to_chars: digits in any base from 2 to 36, lowercase letters, a minus if negative and no terminator.
+	// Returns the end of the written characters, or last and std::errc::value_too_large if it didn't fit (the buffer contents are unspecified then).
+	// Numbers up to chars_stack_limbs limbs are converted on the stack without touching the heap, bigger ones go through to_string().
+	std::to_chars_result to_chars(char* first, char* last, int base = 10) const
+	{
+		if (base < 2 || base > 36)
+		{
+			return { first, std::errc::invalid_argument };
+		}
+
+		const limb_t limb_base = static_cast<limb_t>(base);
+
+		if (value.size() > chars_stack_limbs * limb_bytes)
+		{
+			const std::string digits = mag_to_string(to_limbs(), limb_base, is_negative());
+
+			if (digits.size() > static_cast<size_t>(last - first))
+			{
+				return { last, std::errc::value_too_large };
+			}
+
+			return { std::copy(digits.begin(), digits.end(), first), std::errc() };
+		}
+
+		limb_t limbs[chars_stack_limbs];
+		size_t n = copy_limbs(limbs);
+
+		if (is_negative())
+		{
+			if (first == last)
+			{
+				return { last, std::errc::value_too_large };
+			}
+
+			*first++ = '-';
+		}
+
+		if (n == 0)
+		{
+			if (first == last)
+			{
+				return { last, std::errc::value_too_large };
+			}
+
+			*first++ = '0';
+			return { first, std::errc() };
+		}
+
+		if (std::has_single_bit(limb_base))
+		{
+			const size_t bits_per_digit = std::countr_zero(limb_base);
+			const size_t count = ((n - 1) * limb_bits + std::bit_width(limbs[n - 1]) + bits_per_digit - 1) / bits_per_digit;
+
+			if (count > static_cast<size_t>(last - first))
+			{
+				return { last, std::errc::value_too_large };
+			}
+
+			limbs_write_pow2_digits(limbs, n, limb_base, first, first + count);
+			return { first + count, std::errc() };
+		}
+
+		// Peel off chunks of digits from the bottom, every chunk takes away more than 59 bits so this always has room.
+		const auto [chunk_digits, chunk_base] = digits_per_limb(limb_base);
+		limb_t chunks[chars_stack_limbs + chars_stack_limbs / 8 + 1];
+		size_t chunk_count = 0;
+
+		while (n > 0)
+		{
+			chunks[chunk_count++] = limbs_divrem_1(limbs, limbs, n, chunk_base);
+
+			while (n > 0 && limbs[n - 1] == 0)
+			{
+				n--;
+			}
+		}
+
+		// The top chunk is written out in full on the side to see how many of its digits aren't leading zeros.
+		char top[limb_bits];
+		write_limb_digits(chunks[chunk_count - 1], limb_base, chunk_digits, top + chunk_digits);
+
+		char* const top_begin = std::find_if(top, top + chunk_digits, [](char c) { return c != '0'; });
+		const size_t top_digits = (top + chunk_digits) - top_begin;
+		const size_t count = top_digits + (chunk_count - 1) * chunk_digits;
+
+		if (count > static_cast<size_t>(last - first))
+		{
+			return { last, std::errc::value_too_large };
+		}
+
+		char* out = std::copy(top_begin, top + chunk_digits, first);
+
+		for (size_t i = chunk_count - 1; i > 0; i--)
+		{
+			out += chunk_digits;
+			write_limb_digits(chunks[i - 1], limb_base, chunk_digits, out);
+		}
+
+		return { out, std::errc() };
+	}
+
+	// Parses a number from [first, last) like std::from_chars: an optional minus, then as many digits of the base (2 to 36, either case) as there are.
+	// Returns where the digits stopped. If there weren't any it returns first and std::errc::invalid_argument, and if the number doesn't fit
+	// in the max size of num it returns std::errc::result_out_of_range. num is left alone in both cases.
+	static std::from_chars_result from_chars(const char* first, const char* last, LargeInt& num, int base = 10)
+	{
+		if (base < 2 || base > 36)
+		{
+			return { first, std::errc::invalid_argument };
+		}
+
+		const bool negative = (first != last && *first == '-');
+		const char* const digits = first + (negative ? 1 : 0);
+		const char* end = digits;
+
+		while (end != last && digit_value(*end) < base)
+		{
+			end++;
+		}
+
+		if (end == digits)
+		{
+			return { first, std::errc::invalid_argument };
+		}
+
+		LargeInt result = from_limbs(mag_from_digits(std::string_view(digits, end - digits), static_cast<limb_t>(base)), negative, 0);
+
+		if (num.max_size != 0 && result.size > num.max_size)
+		{
+			return { end, std::errc::result_out_of_range };
+		}
+
+		result.max_size = num.max_size;
+		num = std::move(result);
+
+		return { end, std::errc() };
+	}
+
+protected:
+	std::vector<uint8_t> value;
+	size_t size;
+	size_t max_size;
+
+	constexpr static uint8_t byte_bits = 8;
+
+	// Trim the number if it's above the maximum size.
+	void trim_size()
+	{
+		recalculate_size();
+
+		if (!too_large(size))
+		{
+			return;
+		}
+
+		while (too_large(size))
+		{
+			value.pop_back();
+			size--;
+		}
+
+		// Whatever's left on top after truncating can be redundant too.
+		recalculate_size();
+	}
+
+	// Trims unnecessary 0 and 255 bytes and recalculates the number's size.
+	void recalculate_size()
+	{
+		if (value.size() < 1)
+		{
+			value.push_back(0);
+		}
+
+		// If there's a leading 0 byte and the following byte does not have bit 8 set to 1, trim the byte.
+		// If there's a leading 255 byte and the following byte does not have bit 8 set to 0, trim the byte.
+		// Neither of these should change the actual value of the number.
+		// Bitwise operations can leave megabytes of these, so find where they end first and resize once.
+		const uint8_t top = *value.rbegin();
+
+		if (top == 0 || top == UINT8_MAX)
+		{
+			size_t new_size = value.size();
+			const uint64_t top_word = (top == 0 ? 0 : UINT64_MAX);
+
+			// Skip over the run of bytes equal to the top one, 8 at a time while possible.
+			while (new_size > sizeof(uint64_t))
+			{
+				uint64_t word;
+				std::memcpy(&word, value.data() + new_size - 1 - sizeof(uint64_t), sizeof(uint64_t));
+
+				if (word != top_word)
+				{
+					break;
+				}
+
+				new_size -= sizeof(uint64_t);
+			}
+
+			while (new_size > 1 && value[new_size - 2] == top)
+			{
+				new_size--;
+			}
+
+			// The lowest byte of the run is only needed if the byte below it has the wrong sign.
+			if (new_size > 1 && ((value[new_size - 2] & (1 << (byte_bits - 1))) != 0) == (top == UINT8_MAX))
+			{
+				new_size--;
+			}
+
+			value.resize(new_size);
+		}
+
+		size = value.size();
+	}
+
+	// Left shifts the number in place.
+	// The value is resized once, whole bytes are moved with a single memmove
+	// and the leftover bits are funnel shifted in one pass, so any shift is O(n).
+	void shift_left(size_t bits)
+	{
+		// If the number of shifts is larger than the max amount of bits, the result is 0.
+		if (max_size != 0 && bits > max_size * byte_bits)
+		{
+			value.assign(1, 0);
+			size = 1;
+			return;
+		}
+
+		const size_t byte_shift = bits / byte_bits;
+		const unsigned int bit_shift = bits % byte_bits;
+		const size_t old_size = value.size();
+		const uint8_t sign_byte = (is_negative() ? UINT8_MAX : 0);
+
+		// One extra byte on top for whatever gets shifted out of the old top byte (and the sign).
+		value.resize(old_size + byte_shift + 1);
+		uint8_t* const data = value.data();
+
+		if (bit_shift == 0)
+		{
+			std::memmove(data + byte_shift, data, old_size);
+			data[old_size + byte_shift] = sign_byte;
+		}
+		else
+		{
+			// Go from the top down so every byte is read before it gets overwritten.
+			data[old_size + byte_shift] = static_cast<uint8_t>((sign_byte << bit_shift) | (data[old_size - 1] >> (byte_bits - bit_shift)));
+
+			for (size_t i = old_size - 1; i > 0; i--)
+			{
+				data[i + byte_shift] = static_cast<uint8_t>((data[i] << bit_shift) | (data[i - 1] >> (byte_bits - bit_shift)));
+			}
+
+			data[byte_shift] = static_cast<uint8_t>(data[0] << bit_shift);
+		}
+
+		std::fill(data, data + byte_shift, static_cast<uint8_t>(0));
+
+		trim_size();
+	}
+
+	// Right shifts the number in place (arithmetic shift, so negative numbers stay negative).
+	// Same deal as shift_left: one memmove for whole bytes and one funnel shift pass for the rest.
+	void shift_right(size_t bits)
+	{
+		const size_t byte_shift = bits / byte_bits;
+		const unsigned int bit_shift = bits % byte_bits;
+		const uint8_t sign_byte = (is_negative() ? UINT8_MAX : 0);
+
+		// If the number of shifts is larger than the amount of bits,
+		// the result is 0 if positive or -1 if negative.
+		if (byte_shift >= value.size())
+		{
+			value.assign(1, sign_byte);
+			size = 1;
+			return;
+		}
+
+		const size_t new_size = value.size() - byte_shift;
+		uint8_t* const data = value.data();
+
+		if (bit_shift == 0)
+		{
+			std::memmove(data, data + byte_shift, new_size);
+		}
+		else
+		{
+			// Go from the bottom up so every byte is read before it gets overwritten.
+			for (size_t i = 0; i + 1 < new_size; i++)
+			{
+				data[i] = static_cast<uint8_t>((data[i + byte_shift] >> bit_shift) | (data[i + byte_shift + 1] << (byte_bits - bit_shift)));
+			}
+
+			data[new_size - 1] = static_cast<uint8_t>((data[new_size - 1 + byte_shift] >> bit_shift) | (sign_byte << (byte_bits - bit_shift)));
+		}
+
+		value.resize(new_size);
+
+		recalculate_size();
+	}
+
+	enum class bitwise_op
+	{
+		bit_and,
+		bit_or,
+		bit_xor
+	};
+
+	template<bitwise_op op, typename T>
+	static T bitwise_apply(T a, T b) noexcept
+	{
+		if constexpr (op == bitwise_op::bit_and)
+		{
+			return a & b;
+		}
+		else if constexpr (op == bitwise_op::bit_or)
+		{
+			return a | b;
+		}
+		else
+		{
+			return a ^ b;
+		}
+	}
+
+	// dst = dst op src for n bytes.
+	// 32 bytes at a time with AVX2, 16 with SSE2, then 8 with plain 64-bit words for whatever's left (or if neither is around).
+	template<bitwise_op op>
+	static void bytes_bitwise(uint8_t* dst, const uint8_t* src, size_t n) noexcept
+	{
+		size_t i = 0;
+
+		#if defined (__AVX2__)
+		for (; i + 32 <= n; i += 32)
+		{
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+			if constexpr (op == bitwise_op::bit_and)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(a, b));
+			}
+			else if constexpr (op == bitwise_op::bit_or)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(a, b));
+			}
+			else
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, b));
+			}
+		}
+		#endif
+
+		#if defined (LARGE_VARIABLES_SSE2)
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+			if constexpr (op == bitwise_op::bit_and)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_and_si128(a, b));
+			}
+			else if constexpr (op == bitwise_op::bit_or)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(a, b));
+			}
+			else
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(a, b));
+			}
+		}
+		#endif
+
+		for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+		{
+			uint64_t a;
+			uint64_t b;
+			std::memcpy(&a, dst + i, sizeof(uint64_t));
+			std::memcpy(&b, src + i, sizeof(uint64_t));
+			a = bitwise_apply<op>(a, b);
+			std::memcpy(dst + i, &a, sizeof(uint64_t));
+		}
+
+		for (; i < n; i++)
+		{
+			dst[i] = bitwise_apply<op>(dst[i], src[i]);
+		}
+	}
+
+	enum class add_op
+	{
+		add,
+		subtract,
+		reverse_subtract
+	};
+
+	// One word of dst op src with a carry in and out. Subtracting adds the inverted side with the carry starting at 1.
+	template<add_op op, typename Word>
+	static Word add_apply(Word a, Word b, uint64_t& carry) noexcept
+	{
+		if constexpr (op == add_op::subtract)
+		{
+			b = static_cast<Word>(~b);
+		}
+		else if constexpr (op == add_op::reverse_subtract)
+		{
+			a = static_cast<Word>(~a);
+		}
+
+		const Word sum = static_cast<Word>(a + b);
+		const Word total = static_cast<Word>(sum + carry);
+		carry = (sum < a || total < sum);
+
+		return total;
+	}
+
+	// dst = dst + src, dst - src or src - dst over n bytes of two's complement, with src sign extended by fill past its first src_n bytes.
+	// Whole 64-bit words at a time on little endian machines, since that's where the byte order matches.
+	template<add_op op>
+	static void bytes_add(uint8_t* dst, const uint8_t* src, size_t src_n, uint8_t fill, size_t n) noexcept
+	{
+		uint64_t carry = (op == add_op::add ? 0 : 1);
+		size_t i = 0;
+
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			const uint64_t fill_word = (fill == 0 ? 0 : UINT64_MAX);
+
+			for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+			{
+				uint64_t a;
+				uint64_t b = fill_word;
+				std::memcpy(&a, dst + i, sizeof(uint64_t));
+
+				if (i < src_n)
+				{
+					std::memcpy(&b, src + i, std::min(sizeof(uint64_t), src_n - i));
+				}
+
+				a = add_apply<op>(a, b, carry);
+				std::memcpy(dst + i, &a, sizeof(uint64_t));
+			}
+		}
+
+		for (; i < n; i++)
+		{
+			dst[i] = add_apply<op>(dst[i], (i < src_n ? src[i] : fill), carry);
+		}
+	}
+
+	// value = value + other, value - other or other - value in place.
+	// Both get sign extended to a byte past the longer one, which always fits the exact result, and then it's truncated to the max size.
+	template<add_op op>
+	void add_assign(const LargeInt& other)
+	{
+		const size_t other_n = other.value.size();
+		const uint8_t other_fill = (other.is_negative() ? UINT8_MAX : 0);
+		const size_t n = std::max(value.size(), other_n) + 1;
+
+		value.resize(n, is_negative() ? UINT8_MAX : 0);
+
+		// Other can be this, so only grab its data after resizing.
+		bytes_add<op>(value.data(), other.value.data(), other_n, other_fill, n);
+		trim_size();
+	}
+
+	// Negates the number in place.
+	void negate()
+	{
+		const bool was_negative = is_negative();
+		bytes_negate(value.data(), value.size());
+
+		// Negating the most negative number of a size gives it back, so it needs another byte (like -128 -> 128).
+		if (was_negative && is_negative())
+		{
+			value.push_back(0);
+		}
+
+		trim_size();
+	}
+
+	// Flips every bit of n bytes in place.
+	static void bytes_invert(uint8_t* dst, size_t n) noexcept
+	{
+		#if defined (LARGE_VARIABLES_SSE2)
+		static const uint8_t ones[16] = { UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX,
+										  UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX, UINT8_MAX };
+		size_t i = 0;
+
+		for (; i + sizeof(ones) <= n; i += sizeof(ones))
+		{
+			bytes_bitwise<bitwise_op::bit_xor>(dst + i, ones, sizeof(ones));
+		}
+
+		bytes_bitwise<bitwise_op::bit_xor>(dst + i, ones, n - i);
+		#else
+		for (size_t i = 0; i < n; i++)
+		{
+			dst[i] = static_cast<uint8_t>(~dst[i]);
+		}
+		#endif
+	}
+
+	// Negates n bytes of two's complement in place.
+	static void bytes_negate(uint8_t* dst, size_t n) noexcept
+	{
+		bytes_invert(dst, n);
+
+		for (size_t i = 0; i < n && ++dst[i] == 0; i++)
+		{}
+	}
+
+	// Reverses the bytes of each word_size byte word in n bytes, n being a multiple of word_size.
+	static void bytes_reverse_words(uint8_t* bytes, size_t n, size_t word_size) noexcept
+	{
+		if (word_size == sizeof(uint64_t))
+		{
+			for (size_t i = 0; i < n; i += sizeof(uint64_t))
+			{
+				uint64_t word;
+				std::memcpy(&word, bytes + i, sizeof(uint64_t));
+
+				#if defined (_MSC_VER)
+				word = _byteswap_uint64(word);
+				#else
+				word = __builtin_bswap64(word);
+				#endif
+
+				std::memcpy(bytes + i, &word, sizeof(uint64_t));
+			}
+		}
+		else if (word_size > 1)
+		{
+			for (size_t i = 0; i < n; i += word_size)
+			{
+				std::reverse(bytes + i, bytes + i + word_size);
+			}
+		}
+	}
+
+	// Counts the 1 bits in n bytes.
+	// 32 bytes at a time with AVX2 (nibble lookup table + sum of absolute differences), then whole 64-bit words.
+	static size_t bytes_popcount(const uint8_t* src, size_t n) noexcept
+	{
+		size_t count = 0;
+		size_t i = 0;
+
+		#if defined (__AVX2__)
+		const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+											   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low_mask = _mm256_set1_epi8(0x0f);
+		__m256i total = _mm256_setzero_si256();
+
+		for (; i + 32 <= n; i += 32)
+		{
+			const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			const __m256i low = _mm256_and_si256(data, low_mask);
+			const __m256i high = _mm256_and_si256(_mm256_srli_epi16(data, 4), low_mask);
+			const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, low), _mm256_shuffle_epi8(table, high));
+
+			total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+		}
+
+		alignas(32) uint64_t sums[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(sums), total);
+		count += static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+		#endif
+
+		for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+		{
+			uint64_t word;
+			std::memcpy(&word, src + i, sizeof(uint64_t));
+			count += std::popcount(word);
+		}
+
+		for (; i < n; i++)
+		{
+			count += std::popcount(src[i]);
+		}
+
+		return count;
+	}
+
+	// Does this = this op other.
+	// This number gets sign extended to the length of the result with a single fill and the overlapping part goes
+	// through the vectorized kernel. Past the end of the other number, its sign extension is either all 0s or all 1s,
+	// so that part is a fill, an invert or nothing at all.
+	template<bitwise_op op>
+	void bitwise_assign(const LargeInt& other)
+	{
+		bitwise_assign<op>(other.value.data(), other.value.size(), other.is_negative());
+	}
+
+	// Views are a magnitude, so they're used as is if they're positive and the bytes line up, and negated into a copy otherwise.
+	template<bitwise_op op>
+	void bitwise_assign(const LargeIntView& other)
+	{
+		const std::span<const limb_t> limbs = other.get_limbs();
+
+		if (std::endian::native == std::endian::little && !other.is_negative())
+		{
+			bitwise_assign<op>(reinterpret_cast<const uint8_t*>(limbs.data()), limbs.size_bytes(), false);
+			return;
+		}
+
+		const LargeInt copy = from_limb_span(limbs.data(), limbs.size(), other.is_negative(), 0);
+		bitwise_assign<op>(copy.value.data(), copy.value.size(), copy.is_negative());
+	}
+
+	// value = value op other, where other is other_size bytes of two's complement that are sign extended with other_is_negative.
+	// The top byte of other doesn't have to agree with other_is_negative, it just gets another byte's worth of room if it doesn't.
+	template<bitwise_op op>
+	void bitwise_assign(const uint8_t* other, size_t other_size, bool other_is_negative)
+	{
+		const bool needs_sign_byte = (other_size > 0 && ((other[other_size - 1] & 0x80) != 0) != other_is_negative);
+		size_t length = std::max(value.size(), other_size + (needs_sign_byte ? 1 : 0));
+
+		// Anything past the max size would just get truncated anyway.
+		if (too_large(length))
+		{
+			length = max_size;
+		}
+
+		value.resize(length, is_negative() ? UINT8_MAX : 0);
+
+		const size_t overlap = std::min(length, other_size);
+		bytes_bitwise<op>(value.data(), other, overlap);
+
+		if constexpr (op == bitwise_op::bit_and)
+		{
+			if (!other_is_negative)
+			{
+				std::fill(value.begin() + overlap, value.end(), static_cast<uint8_t>(0));
+			}
+		}
+		else if constexpr (op == bitwise_op::bit_or)
+		{
+			if (other_is_negative)
+			{
+				std::fill(value.begin() + overlap, value.end(), static_cast<uint8_t>(UINT8_MAX));
+			}
+		}
+		else
+		{
+			if (other_is_negative)
+			{
+				bytes_invert(value.data() + overlap, length - overlap);
+			}
+		}
+
+		trim_size();
+	}
+
+	// Everything below works on magnitudes stored as 64-bit limbs (least significant first) instead of the signed bytes above.
+	// A magnitude is "normalized" when it has no leading zero limbs, which makes 0 an empty vector.
+	// The byte representation stays the public face of the class; the heavier algorithms
+	// convert to limbs once, do their thing a whole word at a time and convert back at the end.
+	using limb_t = uint64_t;
+	using limb_vector = std::vector<limb_t>;
+
+	constexpr static uint8_t limb_bits = 64;
+	constexpr static size_t limb_bytes = sizeof(limb_t);
+
+	// Below these sizes (in limbs) the simpler algorithm wins.
+	const static size_t karatsuba_threshold = 32;
+	const static size_t gcd_binary_threshold = 2;
+	const static size_t gcd_hgcd_threshold = 160;
+
+	// See set_parallel_multiplication(). Relaxed atomics, since they're only settings and nothing else hangs off them.
+	static inline std::atomic<size_t> parallel_threshold{ default_parallel_threshold };
+	static inline std::atomic<unsigned int> parallel_threads{ std::max(std::thread::hardware_concurrency(), 1u) };
+
+	// (a; b) = M * (x; y) for whatever (a, b) the matrix was built from and the (x, y) it was reduced to.
+	// All entries are non-negative and the determinant is -1 if odd is set, +1 otherwise.
+	struct gcd_matrix
+	{
+		limb_vector entry[2][2] = { { { 1 }, {} }, { {}, { 1 } } };
+		bool odd = false;
+
+		bool is_identity() const noexcept
+		{
+			return !odd && entry[0][1].empty() && entry[1][0].empty();
+		}
+	};
+
+	// Returns the magnitude of the number as limbs.
+	limb_vector to_limbs() const
+	{
+		limb_vector limbs((value.size() + limb_bytes - 1) / limb_bytes);
+		limbs.resize(copy_limbs(limbs.data()));
+
+		return limbs;
+	}
+
+	// Writes the magnitude of the number into (value.size() + limb_bytes - 1) / limb_bytes limbs and returns how many of them are used.
+	size_t copy_limbs(limb_t* limbs) const noexcept
+	{
+		const bool val_is_negative = is_negative();
+		size_t n = (value.size() + limb_bytes - 1) / limb_bytes;
+		std::fill_n(limbs, n, val_is_negative ? ~limb_t(0) : 0);
+
+		// Whatever isn't overwritten in the top limb is already sign extended.
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			std::memcpy(limbs, value.data(), value.size());
+		}
+		else
+		{
+			for (size_t i = 0; i < value.size(); i++)
+			{
+				const size_t shift = byte_bits * (i % limb_bytes);
+				limbs[i / limb_bytes] = (limbs[i / limb_bytes] & ~(limb_t(UINT8_MAX) << shift)) | (limb_t(value[i]) << shift);
+			}
+		}
+
+		if (val_is_negative)
+		{
+			limbs_negate(limbs, n);
+		}
+
+		while (n > 0 && limbs[n - 1] == 0)
+		{
+			n--;
+		}
+
+		return n;
+	}
+
+	// Builds a number out of a magnitude and a sign.
+	// If the number would take up more bytes than the max size, excess bytes are truncated.
+	static LargeInt from_limbs(const limb_vector& limbs, bool negative, size_t max_size)
+	{
+		return from_limb_span(limbs.data(), limbs.size(), negative, max_size);
+	}
+
+	// Same as above for n limbs of magnitude anywhere in memory.
+	static LargeInt from_limb_span(const limb_t* limbs, size_t n, bool negative, size_t max_size)
+	{
+		// One extra byte so there's always room for the sign bit.
+		LargeInt new_val(0, max_size);
+		new_val.value.resize(n * limb_bytes + 1);
+
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			if (n > 0)
+			{
+				std::memcpy(new_val.value.data(), limbs, n * limb_bytes);
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < n * limb_bytes; i++)
+			{
+				new_val.value[i] = static_cast<uint8_t>(limbs[i / limb_bytes] >> (byte_bits * (i % limb_bytes)));
+			}
+		}
+
+		if (negative)
+		{
+			bytes_negate(new_val.value.data(), new_val.value.size());
+		}
+
+		new_val.trim_size();
+		return new_val;
+	}
+
+	// Returns this * (negative ? -|b| : |b|) for a magnitude b, truncated to this number's max size.
+	LargeInt multiply_magnitude(std::span<const limb_t> b, bool negative) const
+	{
+		const limb_vector a = to_limbs();
+
+		if (a.empty() || b.empty())
+		{
+			return LargeInt(0, max_size);
+		}
+
+		limb_vector result(a.size() + b.size());
+
+		if (a.size() >= b.size())
+		{
+			limbs_mul(result.data(), a.data(), a.size(), b.data(), b.size());
+		}
+		else
+		{
+			limbs_mul(result.data(), b.data(), b.size(), a.data(), a.size());
+		}
+
+		return from_limb_span(result.data(), result.size(), is_negative() != negative, max_size);
+	}
+
+	// Returns this + (negative ? -|b| : |b|) for a magnitude b, truncated to this number's max size.
+	LargeInt add_magnitude(std::span<const limb_t> b, bool negative) const
+	{
+		const limb_vector a = to_limbs();
+
+		if (is_negative() == negative)
+		{
+			limb_vector result(std::max(a.size(), b.size()) + 1);
+			const limb_t* longer = (a.size() >= b.size() ? a.data() : b.data());
+			const limb_t* shorter = (a.size() >= b.size() ? b.data() : a.data());
+			const size_t shorter_size = std::min(a.size(), b.size());
+
+			result.back() = limbs_add(result.data(), longer, result.size() - 1, shorter, shorter_size);
+			return from_limb_span(result.data(), result.size(), negative, max_size);
+		}
+
+		// Different signs, so it's the bigger magnitude minus the smaller one, with the sign of the bigger one.
+		const bool a_is_larger = compare_magnitude(b) >= 0;
+		const limb_t* larger = (a_is_larger ? a.data() : b.data());
+		const limb_t* smaller = (a_is_larger ? b.data() : a.data());
+		const size_t larger_size = (a_is_larger ? a.size() : b.size());
+		limb_vector result(larger_size);
+
+		limbs_sub(result.data(), larger, larger_size, smaller, (a_is_larger ? b.size() : a.size()));
+		return from_limb_span(result.data(), result.size(), (a_is_larger ? is_negative() : negative), max_size);
+	}
+
+	// Compares the magnitude of this number against a normalized magnitude, reading both in place.
+	std::weak_ordering compare_magnitude(std::span<const limb_t> b) const noexcept
+	{
+		const size_t bits = magnitude_bit_length();
+		const size_t b_bits = (b.empty() ? 0 : b.size() * limb_bits - std::countl_zero(b.back()));
+
+		if (bits != b_bits)
+		{
+			return bits <=> b_bits;
+		}
+
+		const size_t lowest_one = (is_negative() ? countr_zero() : 0);
+
+		for (size_t i = b.size(); i > 0; i--)
+		{
+			const limb_t limb = magnitude_limb(i - 1, lowest_one);
+
+			if (limb != b[i - 1])
+			{
+				return limb <=> b[i - 1];
+			}
+		}
+
+		return std::weak_ordering::equivalent;
+	}
+
+	// Returns limb i of the magnitude. For negative numbers that's the inverted limb plus the carry from below,
+	// which only makes it this far if everything below is 0, so lowest_one has to be countr_zero().
+	limb_t magnitude_limb(size_t i, size_t lowest_one) const noexcept
+	{
+		const limb_t raw = raw_bits_at(i * limb_bits);
+
+		if (!is_negative())
+		{
+			return raw;
+		}
+
+		return ~raw + (lowest_one >= i * limb_bits ? 1 : 0);
+	}
+
+	// Full 64x64 -> 128 bit multiplication. Returns the low half and stores the high half.
+	static constexpr limb_t mul_wide(limb_t a, limb_t b, limb_t& high) noexcept
+	{
+		#if defined (__SIZEOF_INT128__)
+		const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+		high = static_cast<limb_t>(product >> limb_bits);
+		return static_cast<limb_t>(product);
+		#else
+		#if defined (_MSC_VER) && defined (_M_X64)
+		if (!std::is_constant_evaluated())
+		{
+			return _umul128(a, b, &high);
+		}
+		#endif
+
+		// Schoolbook on 32-bit halves for when the compiler gives us nothing better (or when it's being worked out at compile time)
+		const limb_t a_low = a & UINT32_MAX, a_high = a >> 32;
+		const limb_t b_low = b & UINT32_MAX, b_high = b >> 32;
+
+		const limb_t low_low = a_low * b_low;
+		const limb_t high_low = a_high * b_low;
+		const limb_t low_high = a_low * b_high;
+		const limb_t middle = (low_low >> 32) + (high_low & UINT32_MAX) + low_high;
+
+		high = a_high * b_high + (high_low >> 32) + (middle >> 32);
+		return (middle << 32) | (low_low & UINT32_MAX);
+		#endif
+	}
+
+	// Divides the 128 bit number (high, low) by divisor, which must be larger than high.
+	// Returns the quotient and stores the remainder.
+	static limb_t div_wide(limb_t high, limb_t low, limb_t divisor, limb_t& remainder) noexcept
+	{
+		#if defined (__SIZEOF_INT128__)
+		const unsigned __int128 dividend = (static_cast<unsigned __int128>(high) << limb_bits) | low;
+		remainder = static_cast<limb_t>(dividend % divisor);
+		return static_cast<limb_t>(dividend / divisor);
+		#elif defined (_MSC_VER) && defined (_M_X64) && _MSC_VER >= 1920
+		return _udiv128(high, low, divisor, &remainder);
+		#else
+		// Long division with 32-bit digits (Hacker's Delight, divlu)
+		const int shift = std::countl_zero(divisor);
+		divisor <<= shift;
+		high = (shift == 0 ? high : (high << shift) | (low >> (limb_bits - shift)));
+		low <<= shift;
+
+		const limb_t divisor_high = divisor >> 32, divisor_low = divisor & UINT32_MAX;
+		const limb_t low_high = low >> 32, low_low = low & UINT32_MAX;
+
+		limb_t quotient_high = high / divisor_high;
+		limb_t rest = high - quotient_high * divisor_high;
+
+		while ((quotient_high >> 32) != 0 || quotient_high * divisor_low > ((rest << 32) | low_high))
+		{
+			quotient_high--;
+			rest += divisor_high;
+
+			if ((rest >> 32) != 0)
+			{
+				break;
+			}
+		}
+
+		const limb_t middle = ((high << 32) | low_high) - quotient_high * divisor;
+
+		limb_t quotient_low = middle / divisor_high;
+		rest = middle - quotient_low * divisor_high;
+
+		while ((quotient_low >> 32) != 0 || quotient_low * divisor_low > ((rest << 32) | low_low))
+		{
+			quotient_low--;
+			rest += divisor_high;
+
+			if ((rest >> 32) != 0)
+			{
+				break;
+			}
+		}
+
+		remainder = (((middle << 32) | low_low) - quotient_low * divisor) >> shift;
+		return (quotient_high << 32) | quotient_low;
+		#endif
+	}
+
+	// Two's complement negation in place.
+	static void limbs_negate(limb_t* a, size_t n) noexcept
+	{
+		bool carry = true;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			a[i] = ~a[i] + (carry ? 1 : 0);
+			carry = carry && a[i] == 0;
+		}
+	}
+
+	// Compares two limb arrays of the same length.
+	static constexpr int limbs_compare(const limb_t* a, const limb_t* b, size_t n) noexcept
+	{
+		for (size_t i = n - 1; i != SIZE_MAX; i--)
+		{
+			if (a[i] != b[i])
+			{
+				return a[i] > b[i] ? 1 : -1;
+			}
+		}
+
+		return 0;
+	}
+
+	// r = a + b, all of length n. Returns the carry.
+	static constexpr limb_t limbs_add_n(limb_t* r, const limb_t* a, const limb_t* b, size_t n) noexcept
+	{
+		limb_t carry = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const limb_t sum = a[i] + carry;
+			carry = (sum < carry);
+			r[i] = sum + b[i];
+			carry += (r[i] < sum);
+		}
+
+		return carry;
+	}
+
+	// r = a + b, where a has length n. Returns the carry.
+	static constexpr limb_t limbs_add_1(limb_t* r, const limb_t* a, size_t n, limb_t b) noexcept
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			r[i] = a[i] + b;
+			b = (r[i] < b);
+		}
+
+		return b;
+	}
+
+	// r = a - b, all of length n. Returns the borrow.
+	static constexpr limb_t limbs_sub_n(limb_t* r, const limb_t* a, const limb_t* b, size_t n) noexcept
+	{
+		limb_t borrow = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const limb_t diff = a[i] - borrow;
+			borrow = (diff > a[i]);
+			r[i] = diff - b[i];
+			borrow += (r[i] > diff);
+		}
+
+		return borrow;
+	}
+
+	// r = a - b, where a has length n. Returns the borrow.
+	static constexpr limb_t limbs_sub_1(limb_t* r, const limb_t* a, size_t n, limb_t b) noexcept
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			const limb_t current = a[i];
+			r[i] = current - b;
+			b = (r[i] > current);
+		}
+
+		return b;
+	}
+
+	// r = a * b, where a has length n. Returns the limb that didn't fit.
+	static constexpr limb_t limbs_mul_1(limb_t* r, const limb_t* a, size_t n, limb_t b) noexcept
+	{
+		limb_t carry = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			limb_t high;
+			limb_t low = mul_wide(a[i], b, high);
+			low += carry;
+			high += (low < carry);
+			r[i] = low;
+			carry = high;
+		}
+
+		return carry;
+	}
+
+	// r += a * b, where a and r have length n. Returns the carry.
+	static constexpr limb_t limbs_addmul_1(limb_t* r, const limb_t* a, size_t n, limb_t b) noexcept
+	{
+		limb_t carry = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			limb_t high;
+			limb_t low = mul_wide(a[i], b, high);
+			low += carry;
+			high += (low < carry);
+			r[i] += low;
+			high += (r[i] < low);
+			carry = high;
+		}
+
+		return carry;
+	}
+
+	// r -= a * b, where a and r have length n. Returns the borrow.
+	static constexpr limb_t limbs_submul_1(limb_t* r, const limb_t* a, size_t n, limb_t b) noexcept
+	{
+		limb_t borrow = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			limb_t high;
+			limb_t low = mul_wide(a[i], b, high);
+			low += borrow;
+			high += (low < borrow);
+			const limb_t current = r[i];
+			r[i] = current - low;
+			high += (r[i] > current);
+			borrow = high;
+		}
+
+		return borrow;
+	}
+
+	// r = a << shift, where a has length n and 0 < shift < limb_bits. Returns the bits shifted out of the top.
+	// r may be the same as a.
+	static limb_t limbs_lshift(limb_t* r, const limb_t* a, size_t n, unsigned int shift) noexcept
+	{
+		const limb_t out = a[n - 1] >> (limb_bits - shift);
+
+		for (size_t i = n - 1; i > 0; i--)
+		{
+			r[i] = (a[i] << shift) | (a[i - 1] >> (limb_bits - shift));
+		}
+
+		r[0] = a[0] << shift;
+		return out;
+	}
+
+	// r = a >> shift, where a has length n and 0 < shift < limb_bits. Returns the bits shifted out of the bottom (at the top of the limb).
+	// r may be the same as a.
+	static limb_t limbs_rshift(limb_t* r, const limb_t* a, size_t n, unsigned int shift) noexcept
+	{
+		const limb_t out = a[0] << (limb_bits - shift);
+
+		for (size_t i = 0; i + 1 < n; i++)
+		{
+			r[i] = (a[i] >> shift) | (a[i + 1] << (limb_bits - shift));
+		}
+
+		r[n - 1] = a[n - 1] >> shift;
+		return out;
+	}
+
+	// Returns floor((2^128 - 1) / d) - 2^64 for a d with its top bit set, so dividing by d can be done with multiplications.
+	static limb_t limb_reciprocal(limb_t d) noexcept
+	{
+		limb_t remainder;
+		return div_wide(~d, ~limb_t(0), d, remainder);
+	}
+
+	// Divides (high, low) by d, which must have its top bit set and be larger than high, using its reciprocal.
+	// Returns the quotient and stores the remainder. (Moller & Granlund, Improved division by invariant integers)
+	static limb_t div_preinv(limb_t high, limb_t low, limb_t d, limb_t reciprocal, limb_t& remainder) noexcept
+	{
+		limb_t quotient_high;
+		const limb_t quotient_low = mul_wide(reciprocal, high, quotient_high) + low;
+		quotient_high += high + 1 + (quotient_low < low ? 1 : 0);
+
+		remainder = low - quotient_high * d;
+
+		if (remainder > quotient_low)
+		{
+			quotient_high--;
+			remainder += d;
+		}
+
+		if (remainder >= d)
+		{
+			quotient_high++;
+			remainder -= d;
+		}
+
+		return quotient_high;
+	}
+
+	// Returns a % d, where a has length n.
+	static limb_t limbs_mod_1(const limb_t* a, size_t n, limb_t d) noexcept
+	{
+		return limbs_divrem_1(nullptr, a, n, d);
+	}
+
+	// q = a / d, where a has length n and q can be a. Returns the remainder. Only the remainder is worked out if q is null.
+	// The divisor is shifted up to have its top bit set so every step is a couple of multiplications with its reciprocal instead of a division.
+	static limb_t limbs_divrem_1(limb_t* q, const limb_t* a, size_t n, limb_t d) noexcept
+	{
+		if (n == 0)
+		{
+			return 0;
+		}
+
+		const int shift = std::countl_zero(d);
+		d <<= shift;
+		const limb_t reciprocal = limb_reciprocal(d);
+
+		// The dividend gets shifted along with the divisor as it goes, the bits pushed out of the top limb start off the remainder.
+		limb_t remainder = (shift == 0 ? 0 : a[n - 1] >> (limb_bits - shift));
+
+		for (size_t i = n - 1; i != SIZE_MAX; i--)
+		{
+			const limb_t low = (shift == 0 ? a[i] : (a[i] << shift) | (i > 0 ? a[i - 1] >> (limb_bits - shift) : 0));
+			const limb_t quotient = div_preinv(remainder, low, d, reciprocal, remainder);
+
+			if (q != nullptr)
+			{
+				q[i] = quotient;
+			}
+		}
+
+		return remainder >> shift;
+	}
+
+	// Schoolbook multiplication. r = a * b, where r has room for an + bn limbs and doesn't overlap either input.
+	static void limbs_mul_basecase(limb_t* r, const limb_t* a, size_t an, const limb_t* b, size_t bn) noexcept
+	{
+		r[an] = limbs_mul_1(r, a, an, b[0]);
+
+		for (size_t i = 1; i < bn; i++)
+		{
+			r[an + i] = limbs_addmul_1(r + i, a, an, b[i]);
+		}
+	}
+
+	// r = a * b, where an >= bn >= 1 and r has room for an + bn limbs and doesn't overlap either input.
+	// Uses Karatsuba above the threshold and splits lopsided products into balanced ones. Big enough products are spread over threads
+	// (see set_parallel_multiplication()).
+	static void limbs_mul(limb_t* r, const limb_t* a, size_t an, const limb_t* b, size_t bn)
+	{
+		limbs_mul_threaded(r, a, an, b, bn, parallel_threads.load(std::memory_order_relaxed));
+	}
+
+	// Same as above, with a budget of threads (counting this one) to run the products that don't depend on each other on.
+	static void limbs_mul_threaded(limb_t* r, const limb_t* a, size_t an, const limb_t* b, size_t bn, unsigned int threads)
+	{
+		if (bn < karatsuba_threshold)
+		{
+			limbs_mul_basecase(r, a, an, b, bn);
+			return;
+		}
+
+		if (bn < parallel_threshold.load(std::memory_order_relaxed))
+		{
+			threads = 1;
+		}
+
+		const size_t half = (an + 1) / 2;
+
+		// If b doesn't reach past the split point, multiply it by each half of a separately.
+		// The two products don't share any memory, so the low one can go on another thread.
+		if (bn <= half)
+		{
+			limb_vector high(an - half + bn);
+			const unsigned int share = std::max(threads / 2, 1u);
+
+			{
+				parallel_task low_worker(threads > 1, [&]()
+				{
+					limbs_mul_threaded(r, a, half, b, bn, share);
+				});
+
+				if (an - half >= bn)
+				{
+					limbs_mul_threaded(high.data(), a + half, an - half, b, bn, std::max(threads - share, 1u));
+				}
+				else
+				{
+					limbs_mul_threaded(high.data(), b, bn, a + half, an - half, std::max(threads - share, 1u));
+				}
+
+				low_worker.wait();
+			}
+
+			std::fill(r + half + bn, r + an + bn, 0);
+			limbs_add_n(r + half, r + half, high.data(), high.size());
+			return;
+		}
+
+		// a = a1 * B^half + a0, b = b1 * B^half + b0
+		// a * b = z2 * B^(2 * half) + (z1 - z2 - z0) * B^half + z0, where z1 = (a0 + a1) * (b0 + b1)
+		const size_t a_high = an - half;
+		const size_t b_high = bn - half;
+
+		limb_vector sum_a(half + 1), sum_b(half + 1), middle(2 * half + 2);
+
+		sum_a[half] = limbs_add(sum_a.data(), a, half, a + half, a_high);
+		sum_b[half] = limbs_add(sum_b.data(), b, half, b + half, b_high);
+
+		// The three products don't share any memory either, so with threads to spare they run side by side, splitting the budget.
+		const unsigned int ways = std::min(threads, 3u);
+		const unsigned int share = threads / ways;
+
+		{
+			parallel_task high_worker(ways > 1, [&]()
+			{
+				limbs_mul_threaded(r + 2 * half, a + half, a_high, b + half, b_high, share);
+			});
+
+			parallel_task middle_worker(ways > 2, [&]()
+			{
+				limbs_mul_threaded(middle.data(), sum_a.data(), half + 1, sum_b.data(), half + 1, share);
+			});
+
+			limbs_mul_threaded(r, a, half, b, half, threads - (ways - 1) * share);
+
+			high_worker.wait();
+			middle_worker.wait();
+		}
+
+		limbs_sub(middle.data(), middle.data(), middle.size(), r, 2 * half);
+		limbs_sub(middle.data(), middle.data(), middle.size(), r + 2 * half, a_high + b_high);
+
+		// The middle term is guaranteed to fit in what's left of the result.
+		const size_t middle_size = std::min(middle.size(), an + bn - half);
+		limbs_add(r + half, r + half, an + bn - half, middle.data(), middle_size);
+	}
+
+	// Runs a task on a thread of its own if asked to, otherwise (or if the thread can't be started) right away on this one.
+	// Either way it's done once wait() returns or the parallel_task is gone. An exception leaving a thread would end the program,
+	// so the thread catches whatever the task throws and wait() rethrows it here. Being destroyed without wait() just drops it,
+	// which only happens when something else is already being thrown.
+	class parallel_task
+	{
+	public:
+		template<typename Task>
+		parallel_task(bool new_thread, const Task& task)
+		{
+			if (new_thread)
+			{
+				try
+				{
+					thread = std::jthread([this, task]()
+					{
+						try
+						{
+							task();
+						}
+						catch (...)
+						{
+							error = std::current_exception();
+						}
+					});
+
+					return;
+				}
+				catch (const std::system_error&)
+				{
+				}
+			}
+
+			task();
+		}
+
+		parallel_task(const parallel_task&) = delete;
+		parallel_task& operator=(const parallel_task&) = delete;
+
+		// Waits for the task to finish and rethrows whatever it threw.
+		void wait()
+		{
+			if (thread.joinable())
+			{
+				thread.join();
+			}
+
+			if (error)
+			{
+				std::rethrow_exception(std::exchange(error, nullptr));
+			}
+		}
+
+	private:
+		std::exception_ptr error;
+		std::jthread thread;	// After error, so it's joined before error goes away
+	};
+
+	// r = a + b, where an >= bn. r may be the same as a. Returns the carry.
+	static limb_t limbs_add(limb_t* r, const limb_t* a, size_t an, const limb_t* b, size_t bn) noexcept
+	{
+		const limb_t carry = limbs_add_n(r, a, b, bn);
+		return limbs_add_1(r + bn, a + bn, an - bn, carry);
+	}
+
+	// r = a - b, where an >= bn. r may be the same as a. Returns the borrow.
+	static limb_t limbs_sub(limb_t* r, const limb_t* a, size_t an, const limb_t* b, size_t bn) noexcept
+	{
+		const limb_t borrow = limbs_sub_n(r, a, b, bn);
+		return limbs_sub_1(r + bn, a + bn, an - bn, borrow);
+	}
+
+	// Removes leading zero limbs.
+	static void mag_normalize(limb_vector& a) noexcept
+	{
+		while (!a.empty() && a.back() == 0)
+		{
+			a.pop_back();
+		}
+	}
+
+	// Compares two normalized magnitudes.
+	static int mag_compare(const limb_vector& a, const limb_vector& b) noexcept
+	{
+		if (a.size() != b.size())
+		{
+			return a.size() > b.size() ? 1 : -1;
+		}
+
+		return a.empty() ? 0 : limbs_compare(a.data(), b.data(), a.size());
+	}
+
+	// Returns the number of significant bits in a normalized magnitude.
+	static size_t mag_bit_length(const limb_vector& a) noexcept
+	{
+		return a.empty() ? 0 : a.size() * limb_bits - std::countl_zero(a.back());
+	}
+
+	// Returns the number of trailing zero bits in a non-zero normalized magnitude.
+	static size_t mag_countr_zero(const limb_vector& a) noexcept
+	{
+		size_t i = 0;
+
+		while (a[i] == 0)
+		{
+			i++;
+		}
+
+		return i * limb_bits + std::countr_zero(a[i]);
+	}
+
+	// Shifts a normalized magnitude left by the given amount of bits.
+	static void mag_shift_left(limb_vector& a, size_t bits)
+	{
+		if (a.empty() || bits == 0)
+		{
+			return;
+		}
+
+		const size_t limbs = bits / limb_bits;
+		const unsigned int shift = bits % limb_bits;
+		const size_t old_size = a.size();
+
+		a.resize(old_size + limbs + 1);
+		a[old_size + limbs] = (shift == 0 ? 0 : limbs_lshift(a.data() + limbs, a.data(), old_size, shift));
+
+		if (shift == 0)
+		{
+			std::memmove(a.data() + limbs, a.data(), old_size * sizeof(limb_t));
+		}
+
+		std::fill(a.begin(), a.begin() + limbs, 0);
+		mag_normalize(a);
+	}
+
+	// Shifts a normalized magnitude right by the given amount of bits.
+	static void mag_shift_right(limb_vector& a, size_t bits)
+	{
+		const size_t limbs = bits / limb_bits;
+		const unsigned int shift = bits % limb_bits;
+
+		if (limbs >= a.size())
+		{
+			a.clear();
+			return;
+		}
+
+		a.erase(a.begin(), a.begin() + limbs);
+
+		if (shift != 0)
+		{
+			limbs_rshift(a.data(), a.data(), a.size(), shift);
+		}
+
+		mag_normalize(a);
+	}
+
+	// Adds two normalized magnitudes.
+	static limb_vector mag_add(const limb_vector& a, const limb_vector& b)
+	{
+		if (a.size() < b.size())
+		{
+			return mag_add(b, a);
+		}
+
+		limb_vector result(a.size() + 1);
+		result[a.size()] = limbs_add(result.data(), a.data(), a.size(), b.data(), b.size());
+
+		mag_normalize(result);
+		return result;
+	}
+
+	// Subtracts two normalized magnitudes, where a >= b.
+	static limb_vector mag_sub(const limb_vector& a, const limb_vector& b)
+	{
+		limb_vector result(a.size());
+		limbs_sub(result.data(), a.data(), a.size(), b.data(), b.size());
+
+		mag_normalize(result);
+		return result;
+	}
+
+	// Returns |a - b| and whether a - b is negative.
+	static limb_vector mag_sub_signed(const limb_vector& a, const limb_vector& b, bool& negative)
+	{
+		negative = mag_compare(a, b) < 0;
+		return negative ? mag_sub(b, a) : mag_sub(a, b);
+	}
+
+	// A magnitude and a sign, for sums that are put together a term at a time.
+	struct signed_limbs
+	{
+		limb_vector magnitude;
+		bool negative = false;
+	};
+
+	// out += b (or -= if negative), for a normalized magnitude of bn limbs. Works in out's own storage and only grows it when a carry needs to go somewhere.
+	static void signed_add(signed_limbs& out, const limb_t* b, size_t bn, bool negative)
+	{
+		limb_vector& a = out.magnitude;
+
+		if (bn == 0)
+		{
+			return;
+		}
+
+		if (a.empty() || out.negative == negative)
+		{
+			out.negative = negative;
+
+			if (a.size() < bn + 1)
+			{
+				a.resize(bn + 1, 0);
+			}
+
+			const limb_t carry = limbs_add(a.data(), a.data(), a.size(), b, bn);
+
+			if (carry != 0)
+			{
+				a.push_back(carry);
+			}
+		}
+		else if (a.size() > bn || (a.size() == bn && limbs_compare(a.data(), b, bn) >= 0))
+		{
+			limbs_sub(a.data(), a.data(), a.size(), b, bn);
+		}
+		else
+		{
+			// b is bigger, so the result is b - a with b's sign. limbs_sub_n can write over its second operand.
+			const size_t an = a.size();
+			a.resize(bn, 0);
+
+			const limb_t borrow = limbs_sub_n(a.data(), b, a.data(), an);
+			limbs_sub_1(a.data() + an, b + an, bn - an, borrow);
+
+			out.negative = negative;
+		}
+
+		mag_normalize(a);
+		out.negative = out.negative && !a.empty();
+	}
+
+	// Wraps a signed magnitude around to max_size bytes the same way the operators wrap a LargeInt. A max size of 0 leaves it alone.
+	static void signed_truncate(signed_limbs& a, size_t max_size)
+	{
+		if (max_size == 0 || mag_bit_length(a.magnitude) < max_size * byte_bits)
+		{
+			return;
+		}
+
+		const LargeInt wrapped = from_limbs(a.magnitude, a.negative, max_size);
+		a.magnitude = wrapped.to_limbs();
+		a.negative = wrapped.is_negative();
+	}
+
+	// out += a * b (or -= if negative) for normalized magnitudes. A single limb factor is multiplied straight into out,
+	// anything bigger goes through one scratch product of exactly a.size() + b.size() limbs.
+	static void signed_addmul(signed_limbs& out, const limb_vector& a, const limb_vector& b, bool negative)
+	{
+		if (a.empty() || b.empty())
+		{
+			return;
+		}
+
+		const limb_vector& longer = (a.size() >= b.size() ? a : b);
+		const limb_vector& shorter = (a.size() >= b.size() ? b : a);
+
+		if (shorter.size() == 1 && (out.magnitude.empty() || out.negative == negative))
+		{
+			limb_vector& r = out.magnitude;
+			r.resize(std::max(r.size(), longer.size()) + 1, 0);
+
+			const limb_t carry = limbs_addmul_1(r.data(), longer.data(), longer.size(), shorter[0]);
+			const limb_t overflow = limbs_add_1(r.data() + longer.size(), r.data() + longer.size(), r.size() - longer.size(), carry);
+
+			if (overflow != 0)
+			{
+				r.push_back(overflow);
+			}
+
+			out.negative = negative;
+			mag_normalize(r);
+			return;
+		}
+
+		limb_vector product(longer.size() + shorter.size());
+		limbs_mul(product.data(), longer.data(), longer.size(), shorter.data(), shorter.size());
+		mag_normalize(product);
+
+		signed_add(out, product.data(), product.size(), negative);
+	}
+
+	// The limb in the first count (up to limb_bytes) little endian bytes of src, sign extended by fill.
+	static limb_t bytes_load_limb(const uint8_t* src, size_t count, uint8_t fill) noexcept
+	{
+		limb_t limb = (fill == 0 ? 0 : ~limb_t(0));
+
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			std::memcpy(&limb, src, count);
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const size_t shift = byte_bits * i;
+				limb = (limb & ~(limb_t(UINT8_MAX) << shift)) | (limb_t(src[i]) << shift);
+			}
+		}
+
+		return limb;
+	}
+
+	// Writes a limb as limb_bytes little endian bytes.
+	static void bytes_store_limb(uint8_t* dst, limb_t limb) noexcept
+	{
+		if constexpr (std::endian::native == std::endian::little)
+		{
+			std::memcpy(dst, &limb, limb_bytes);
+		}
+		else
+		{
+			for (size_t i = 0; i < limb_bytes; i++)
+			{
+				dst[i] = static_cast<uint8_t>(limb >> (byte_bits * i));
+			}
+		}
+	}
+
+	// dst += src * w (or -= for add_op::subtract) over n bytes of two's complement, n being a whole number of limbs,
+	// with src sign extended by fill past its first src_n bytes. The same step as limbs_addmul_1() and limbs_submul_1(), just loading
+	// and storing the bytes a limb at a time. Whatever carries out of the top is dropped, which is what makes the signs work out.
+	// src can be dst.
+	template<add_op op>
+	static void bytes_addmul_1(uint8_t* dst, const uint8_t* src, size_t src_n, uint8_t fill, size_t n, limb_t w) noexcept
+	{
+		const limb_t fill_limb = (fill == 0 ? 0 : ~limb_t(0));
+		limb_t carry = 0;
+
+		for (size_t i = 0; i < n; i += limb_bytes)
+		{
+			const limb_t b = (i < src_n ? bytes_load_limb(src + i, std::min(limb_bytes, src_n - i), fill) : fill_limb);
+			const limb_t a = bytes_load_limb(dst + i, limb_bytes, 0);
+
+			limb_t high;
+			limb_t low = mul_wide(b, w, high);
+			low += carry;
+			high += (low < carry);
+
+			limb_t r;
+
+			if constexpr (op == add_op::subtract)
+			{
+				r = a - low;
+				high += (r > a);
+			}
+			else
+			{
+				r = a + low;
+				high += (r < low);
+			}
+
+			bytes_store_limb(dst + i, r);
+			carry = high;
+		}
+	}
+
+	// dst += src (or -= for add_op::subtract) over n bytes of two's complement, n being a whole number of limbs, for a magnitude of src_n limbs.
+	template<add_op op>
+	static void bytes_add_limbs(uint8_t* dst, const limb_t* src, size_t src_n, size_t n) noexcept
+	{
+		uint64_t carry = (op == add_op::add ? 0 : 1);
+
+		for (size_t i = 0; i < n / limb_bytes; i++)
+		{
+			const limb_t a = bytes_load_limb(dst + i * limb_bytes, limb_bytes, 0);
+			bytes_store_limb(dst + i * limb_bytes, add_apply<op>(a, (i < src_n ? src[i] : 0), carry));
+		}
+	}
+
+	// Sign extends the number to whole limbs, past both its own length and extra_bytes. That's always room for the exact result
+	// of adding a product of up to extra_bytes bytes to it. Returns the new length in bytes.
+	size_t extend_for_product(size_t extra_bytes)
+	{
+		const size_t n = (std::max(value.size(), extra_bytes) / limb_bytes + 1) * limb_bytes;
+		value.resize(n, is_negative() ? UINT8_MAX : 0);
+
+		return n;
+	}
+
+	// this += b * w (or -= if subtract) for a single limb w, multiplied straight into this number's bytes.
+	LargeInt& accumulate_word_product(const LargeInt& b, limb_t w, bool subtract)
+	{
+		const size_t b_n = b.value.size();
+		const uint8_t b_fill = (b.is_negative() ? UINT8_MAX : 0);
+		const size_t n = extend_for_product(b_n + limb_bytes);
+
+		// b can be this, so only grab its data after resizing.
+		if (subtract)
+		{
+			bytes_addmul_1<add_op::subtract>(value.data(), b.value.data(), b_n, b_fill, n, w);
+		}
+		else
+		{
+			bytes_addmul_1<add_op::add>(value.data(), b.value.data(), b_n, b_fill, n, w);
+		}
+
+		trim_size();
+		return *this;
+	}
+
+	// this += b * c (or -= if subtract) in this number's own bytes. If either side fits in a limb it's multiplied straight in,
+	// otherwise both magnitudes and their product share a single scratch buffer.
+	LargeInt& accumulate_product(const LargeInt& b, const LargeInt& c, bool subtract)
+	{
+		if (b.size <= limb_bytes || c.size <= limb_bytes)
+		{
+			const bool c_is_word = (c.size <= limb_bytes);
+			const LargeInt& word = (c_is_word ? c : b);
+			const bool word_negative = word.is_negative();
+			const limb_t w = bytes_load_limb(word.value.data(), word.value.size(), word_negative ? UINT8_MAX : 0);
+
+			return accumulate_word_product(c_is_word ? b : c, (word_negative ? 0 - w : w), subtract != word_negative);
+		}
+
+		// Room for what copy_limbs() writes, give or take a limb
+		const size_t b_limbs = b.value.size() / limb_bytes + 1;
+		const size_t c_limbs = c.value.size() / limb_bytes + 1;
+		const bool negative = (subtract != (b.is_negative() != c.is_negative()));
+
+		limb_vector scratch(2 * (b_limbs + c_limbs));
+		limb_t* const b_mag = scratch.data();
+		limb_t* const c_mag = b_mag + b_limbs;
+		limb_t* const product = c_mag + c_limbs;
+
+		const size_t bn = b.copy_limbs(b_mag);
+		const size_t cn = c.copy_limbs(c_mag);
+
+		if (bn == 0 || cn == 0)
+		{
+			return *this;
+		}
+
+		if (bn >= cn)
+		{
+			limbs_mul(product, b_mag, bn, c_mag, cn);
+		}
+		else
+		{
+			limbs_mul(product, c_mag, cn, b_mag, bn);
+		}
+
+		// b and c can be this, and they're done with now.
+		const size_t n = extend_for_product((bn + cn) * limb_bytes);
+
+		if (negative)
+		{
+			bytes_add_limbs<add_op::subtract>(value.data(), product, bn + cn, n);
+		}
+		else
+		{
+			bytes_add_limbs<add_op::add>(value.data(), product, bn + cn, n);
+		}
+
+		trim_size();
+		return *this;
+	}
+
+	// The magnitude of a built-in integer, and the same as normalized limbs.
+	template<typename Integer>
+	static constexpr limb_t word_magnitude(Integer val) noexcept
+	{
+		const limb_t magnitude = static_cast<limb_t>(val);
+		return (word_is_negative(val) ? 0 - magnitude : magnitude);
+	}
+
+	template<typename Integer>
+	static constexpr bool word_is_negative(Integer val) noexcept
+	{
+		if constexpr (std::is_signed<Integer>::value)
+		{
+			return val < 0;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// Multiplies two normalized magnitudes.
+	static limb_vector mag_mul(const limb_vector& a, const limb_vector& b)
+	{
+		if (a.empty() || b.empty())
+		{
+			return {};
+		}
+
+		limb_vector result(a.size() + b.size());
+
+		if (a.size() >= b.size())
+		{
+			limbs_mul(result.data(), a.data(), a.size(), b.data(), b.size());
+		}
+		else
+		{
+			limbs_mul(result.data(), b.data(), b.size(), a.data(), a.size());
+		}
+
+		mag_normalize(result);
+		return result;
+	}
+
+	// Returns a * x + b * y for single limbs x and y.
+	static limb_vector mag_mul_1_add(const limb_vector& a, limb_t x, const limb_vector& b, limb_t y)
+	{
+		const size_t size = std::max(a.size(), b.size());
+		limb_vector result(size + 2);
+
+		if (!a.empty())
+		{
+			result[a.size()] = limbs_mul_1(result.data(), a.data(), a.size(), x);
+		}
+
+		if (!b.empty())
+		{
+			const limb_t carry = limbs_addmul_1(result.data(), b.data(), b.size(), y);
+			limbs_add_1(result.data() + b.size(), result.data() + b.size(), result.size() - b.size(), carry);
+		}
+
+		mag_normalize(result);
+		return result;
+	}
+
+	// Divides two normalized magnitudes (Knuth's algorithm D), optionally storing the remainder.
+	// Throws div_by_zero if the divisor is 0.
+	static limb_vector mag_divmod(const limb_vector& a, const limb_vector& d, limb_vector* remainder)
+	{
+		if (d.empty())
+		{
+			// oopsies :3
+			throw div_by_zero("LargeInt division by zero.");
+		}
+
+		if (mag_compare(a, d) < 0)
+		{
+			if (remainder != nullptr)
+			{
+				*remainder = a;
+			}
+
+			return {};
+		}
+
+		const size_t n = d.size();
+		limb_vector quotient(a.size() - n + 1);
+
+		if (n == 1)
+		{
+			const limb_t rest = limbs_divrem_1(quotient.data(), a.data(), a.size(), d[0]);
+
+			if (remainder != nullptr)
+			{
+				*remainder = (rest == 0 ? limb_vector() : limb_vector{ rest });
+			}
+
+			mag_normalize(quotient);
+			return quotient;
+		}
+
+		// Normalize so the divisor's top bit is set, which keeps the quotient estimates within 2 of the real thing.
+		const unsigned int shift = std::countl_zero(d.back());
+		limb_vector divisor = d;
+		limb_vector rest(a.size() + 1);
+
+		if (shift != 0)
+		{
+			limbs_lshift(divisor.data(), d.data(), n, shift);
+			rest[a.size()] = limbs_lshift(rest.data(), a.data(), a.size(), shift);
+		}
+		else
+		{
+			std::copy(a.begin(), a.end(), rest.begin());
+		}
+
+		const limb_t divisor_top = divisor[n - 1];
+		const limb_t divisor_next = divisor[n - 2];
+
+		for (size_t j = a.size() - n; j != SIZE_MAX; j--)
+		{
+			limb_t estimate;
+			limb_t estimate_rest;
+			bool refine;
+
+			// The top limb can't be bigger than the divisor's, but it can be equal.
+			if (rest[j + n] >= divisor_top)
+			{
+				estimate = ~limb_t(0);
+				estimate_rest = rest[j + n - 1] + divisor_top;
+				refine = estimate_rest >= divisor_top;
+			}
+			else
+			{
+				estimate = div_wide(rest[j + n], rest[j + n - 1], divisor_top, estimate_rest);
+				refine = true;
+			}
+
+			while (refine)
+			{
+				limb_t high;
+				const limb_t low = mul_wide(estimate, divisor_next, high);
+
+				if (high < estimate_rest || (high == estimate_rest && low <= rest[j + n - 2]))
+				{
+					break;
+				}
+
+				estimate--;
+				estimate_rest += divisor_top;
+				refine = estimate_rest >= divisor_top;
+			}
+
+			// Now the estimate is at most 1 too large, which gets fixed by adding the divisor back.
+			const limb_t borrow = limbs_submul_1(rest.data() + j, divisor.data(), n, estimate);
+			const limb_t top = rest[j + n];
+			rest[j + n] = top - borrow;
+
+			if (top < borrow)
+			{
+				estimate--;
+				rest[j + n] += limbs_add_n(rest.data() + j, rest.data() + j, divisor.data(), n);
+			}
+
+			quotient[j] = estimate;
+		}
+
+		if (remainder != nullptr)
+		{
+			remainder->assign(rest.begin(), rest.begin() + n);
+
+			if (shift != 0)
+			{
+				limbs_rshift(remainder->data(), remainder->data(), n, shift);
+			}
+
+			mag_normalize(*remainder);
+		}
+
+		mag_normalize(quotient);
+		return quotient;
+	}
+
+	// Binary gcd of two single limbs.
+	static limb_t limb_gcd(limb_t a, limb_t b) noexcept
+	{
+		if (a == 0 || b == 0)
+		{
+			return a | b;
+		}
+
+		const int common = std::countr_zero(a | b);
+		a >>= std::countr_zero(a);
+
+		do
+		{
+			b >>= std::countr_zero(b);
+
+			if (a > b)
+			{
+				std::swap(a, b);
+			}
+
+			b -= a;
+		} while (b != 0);
+
+		return a << common;
+	}
+
+	// Binary gcd of two non-zero normalized magnitudes. Only worth it for a handful of limbs.
+	static limb_vector mag_gcd_binary(limb_vector a, limb_vector b)
+	{
+		const size_t a_zeros = mag_countr_zero(a);
+		const size_t b_zeros = mag_countr_zero(b);
+
+		mag_shift_right(a, a_zeros);
+		mag_shift_right(b, b_zeros);
+
+		// Both are odd from here on, so their difference is even and can be shifted down again.
+		while (true)
+		{
+			const int order = mag_compare(a, b);
+
+			if (order == 0)
+			{
+				break;
+			}
+			else if (order < 0)
+			{
+				std::swap(a, b);
+			}
+
+			limbs_sub(a.data(), a.data(), a.size(), b.data(), b.size());
+			mag_normalize(a);
+			mag_shift_right(a, mag_countr_zero(a));
+		}
+
+		mag_shift_left(a, std::min(a_zeros, b_zeros));
+		return a;
+	}
+
+	// Returns M * N.
+	static gcd_matrix mag_matrix_mul(const gcd_matrix& m, const gcd_matrix& n)
+	{
+		gcd_matrix result;
+
+		for (size_t row = 0; row < 2; row++)
+		{
+			for (size_t col = 0; col < 2; col++)
+			{
+				result.entry[row][col] = mag_add(mag_mul(m.entry[row][0], n.entry[0][col]), mag_mul(m.entry[row][1], n.entry[1][col]));
+			}
+		}
+
+		result.odd = (m.odd != n.odd);
+		return result;
+	}
+
+	// One step of Euclid's algorithm: (a, b) = (b, a mod b), with M = M * (q 1; 1 0).
+	static void mag_euclid_step(limb_vector& a, limb_vector& b, gcd_matrix* m)
+	{
+		limb_vector remainder;
+		const limb_vector quotient = mag_divmod(a, b, &remainder);
+
+		a = std::move(b);
+		b = std::move(remainder);
+
+		if (m != nullptr)
+		{
+			for (size_t row = 0; row < 2; row++)
+			{
+				limb_vector entry = mag_add(mag_mul(m->entry[row][0], quotient), m->entry[row][1]);
+				m->entry[row][1] = std::move(m->entry[row][0]);
+				m->entry[row][0] = std::move(entry);
+			}
+
+			m->odd = !m->odd;
+		}
+	}
+
+	// Returns x * a + y * b, where x and y have opposite signs (or one is 0) and the result is known to be non-negative.
+	static limb_vector mag_lehmer_combine(const limb_vector& a, int64_t x, const limb_vector& b, int64_t y)
+	{
+		if (x < 0 || y > 0)
+		{
+			return mag_lehmer_combine(b, y, a, x);
+		}
+
+		limb_vector result(std::max(a.size(), b.size()) + 1);
+		result[a.size()] = limbs_mul_1(result.data(), a.data(), a.size(), static_cast<limb_t>(x));
+
+		const limb_t borrow = limbs_submul_1(result.data(), b.data(), b.size(), static_cast<limb_t>(-y));
+		limbs_sub_1(result.data() + b.size(), result.data() + b.size(), result.size() - b.size(), borrow);
+
+		mag_normalize(result);
+		return result;
+	}
+
+	// One step of Lehmer's algorithm on a >= b > 0.
+	// Runs Euclid on the leading 62 bits of both numbers for as long as the quotients are guaranteed
+	// to match the real ones (Knuth's algorithm L), then applies all of them at once with single limb multiplications.
+	// Returns false if not even one quotient could be worked out, in which case the caller needs to do a full division.
+	static bool mag_lehmer_step(limb_vector& a, limb_vector& b, gcd_matrix* m)
+	{
+		const size_t a_bits = mag_bit_length(a);
+		const size_t shift = (a_bits > 62 ? a_bits - 62 : 0);
+
+		auto leading_bits = [shift](const limb_vector& num) -> int64_t
+		{
+			const size_t index = shift / limb_bits;
+			const unsigned int offset = shift % limb_bits;
+
+			if (index >= num.size())
+			{
+				return 0;
+			}
+
+			limb_t bits = num[index] >> offset;
+
+			if (offset != 0 && index + 1 < num.size())
+			{
+				bits |= num[index + 1] << (limb_bits - offset);
+			}
+
+			return static_cast<int64_t>(bits);
+		};
+
+		int64_t x = leading_bits(a);
+		int64_t y = leading_bits(b);
+		int64_t A = 1, B = 0, C = 0, D = 1;
+		bool odd = false;
+
+		// Everything stays below 2^62 so none of this can overflow.
+		while (y + C > 0 && y + D > 0)
+		{
+			const int64_t quotient = (x + A) / (y + C);
+
+			if (quotient != (x + B) / (y + D))
+			{
+				break;
+			}
+
+			int64_t temp = A - quotient * C;
+			A = C;
+			C = temp;
+			temp = B - quotient * D;
+			B = D;
+			D = temp;
+			temp = x - quotient * y;
+			x = y;
+			y = temp;
+			odd = !odd;
+		}
+
+		if (B == 0)
+		{
+			return false;
+		}
+
+		limb_vector new_a = mag_lehmer_combine(a, A, b, B);
+		limb_vector new_b = mag_lehmer_combine(a, C, b, D);
+
+		a = std::move(new_a);
+		b = std::move(new_b);
+
+		// (A B; C D) maps the old pair to the new one, so M picks up its inverse, which is (|D| |B|; |C| |A|).
+		if (m != nullptr)
+		{
+			const limb_t abs_a = static_cast<limb_t>(A < 0 ? -A : A);
+			const limb_t abs_b = static_cast<limb_t>(B < 0 ? -B : B);
+			const limb_t abs_c = static_cast<limb_t>(C < 0 ? -C : C);
+			const limb_t abs_d = static_cast<limb_t>(D < 0 ? -D : D);
+
+			for (size_t row = 0; row < 2; row++)
+			{
+				limb_vector first = mag_mul_1_add(m->entry[row][0], abs_d, m->entry[row][1], abs_c);
+				m->entry[row][1] = mag_mul_1_add(m->entry[row][0], abs_b, m->entry[row][1], abs_a);
+				m->entry[row][0] = std::move(first);
+			}
+
+			m->odd = (m->odd != odd);
+		}
+
+		return true;
+	}
+
+	// Reduces a >= b with Lehmer steps until b has at most target limbs.
+	static void mag_lehmer_reduce(limb_vector& a, limb_vector& b, gcd_matrix* m, size_t target)
+	{
+		while (b.size() > target)
+		{
+			if (a.size() > b.size() + 1 || !mag_lehmer_step(a, b, m))
+			{
+				mag_euclid_step(a, b, m);
+			}
+		}
+	}
+
+	// Applies the reduction worked out for the top part of a and b (everything past the first skip limbs) to the whole numbers.
+	// (x; y) = M^-1 * (a; b) = det(M) * (m11 * a - m01 * b; m00 * b - m10 * a)
+	// Returns false if the matrix doesn't hold for the whole numbers, which is rare but can happen
+	// if the top part got reduced too far. In that case a, b and m are left untouched.
+	static bool mag_hgcd_step(limb_vector& a, limb_vector& b, size_t skip, gcd_matrix* m)
+	{
+		if (b.size() <= skip + 1)
+		{
+			return false;
+		}
+
+		limb_vector top_a(a.begin() + skip, a.end());
+		limb_vector top_b(b.begin() + skip, b.end());
+		gcd_matrix reduction;
+
+		mag_hgcd(top_a, top_b, reduction);
+
+		if (reduction.is_identity())
+		{
+			return false;
+		}
+
+		bool x_negative;
+		bool y_negative;
+		limb_vector x = mag_sub_signed(mag_mul(reduction.entry[1][1], a), mag_mul(reduction.entry[0][1], b), x_negative);
+		limb_vector y = mag_sub_signed(mag_mul(reduction.entry[0][0], b), mag_mul(reduction.entry[1][0], a), y_negative);
+
+		// Both have to come out with the sign of the determinant (or be zero) and x > y.
+		if ((!x.empty() && x_negative != reduction.odd) || (!y.empty() && y_negative != reduction.odd) || mag_compare(x, y) <= 0)
+		{
+			return false;
+		}
+
+		a = std::move(x);
+		b = std::move(y);
+
+		if (m != nullptr)
+		{
+			*m = mag_matrix_mul(*m, reduction);
+		}
+
+		return true;
+	}
+
+	// Half gcd. Reduces a >= b until b has about half as many limbs as a had (n / 2 + 1),
+	// accumulating the quotients into m. The two recursive calls each work on numbers half the size,
+	// which makes the whole thing subquadratic as long as multiplication is.
+	static void mag_hgcd(limb_vector& a, limb_vector& b, gcd_matrix& m)
+	{
+		const size_t n = a.size();
+		const size_t target = n / 2 + 1;
+
+		if (b.size() <= target)
+		{
+			return;
+		}
+
+		if (n < gcd_hgcd_threshold)
+		{
+			mag_lehmer_reduce(a, b, &m, target);
+			return;
+		}
+
+		// Reducing the top half to half its size gets b down to roughly 3/4 of n.
+		mag_hgcd_step(a, b, n / 2, &m);
+
+		if (b.size() <= target)
+		{
+			return;
+		}
+
+		mag_euclid_step(a, b, &m);
+
+		if (b.size() <= target)
+		{
+			return;
+		}
+
+		// Choose the second split so that reducing the top part to half its size lands right at the target.
+		const size_t current = a.size();
+
+		if (2 * target > current)
+		{
+			mag_hgcd_step(a, b, 2 * target - current, &m);
+		}
+
+		mag_lehmer_reduce(a, b, &m, target);
+	}
+
+	// Computes the gcd of two normalized magnitudes.
+	// If m isn't null, it ends up as the matrix where (a; b) = M * (g; 0), which is where the cofactors come from.
+	static limb_vector mag_gcd(limb_vector a, limb_vector b, gcd_matrix* m)
+	{
+		if (mag_compare(a, b) < 0)
+		{
+			std::swap(a, b);
+
+			// (b; a) = (0 1; 1 0) * (a; b)
+			if (m != nullptr)
+			{
+				std::swap(m->entry[0][0], m->entry[0][1]);
+				std::swap(m->entry[1][0], m->entry[1][1]);
+				m->odd = !m->odd;
+			}
+		}
+
+		while (!b.empty())
+		{
+			if (m == nullptr && a.size() == 1)
+			{
+				a[0] = limb_gcd(a[0], b[0]);
+				break;
+			}
+			else if (m == nullptr && a.size() <= gcd_binary_threshold)
+			{
+				a = mag_gcd_binary(std::move(a), std::move(b));
+				break;
+			}
+			else if (a.size() > b.size() + 1 || a.size() == 1)
+			{
+				// Way too lopsided (or too small) for anything clever, a division gets them in line.
+				mag_euclid_step(a, b, m);
+			}
+			else if (b.size() >= gcd_hgcd_threshold && mag_hgcd_step(a, b, a.size() / 3, m))
+			{
+				continue;
+			}
+			else if (!mag_lehmer_step(a, b, m))
+			{
+				mag_euclid_step(a, b, m);
+			}
+		}
+
+		return a;
+	}
+
+	// Returns the inverse of an odd limb modulo 2^64.
+	static limb_t limb_inverse(limb_t a) noexcept
+	{
+		// Newton's iteration doubles the correct bits every step and a * a == 1 (mod 8) for any odd a, so that's 3 -> 6 -> 12 -> 24 -> 48 -> 96.
+		limb_t inverse = a;
+
+		for (int i = 0; i < 5; i++)
+		{
+			inverse *= 2 - a * inverse;
+		}
+
+		return inverse;
+	}
+
+	// Divides a by an odd d, where d is known to divide a exactly.
+	// Works from the bottom up (Hensel division): every quotient limb is just the current low limb times the inverse of d,
+	// so there's no normalizing, no estimating and no correction steps.
+	static limb_vector mag_divexact(limb_vector a, const limb_vector& d)
+	{
+		if (a.size() < d.size())
+		{
+			return {};
+		}
+
+		const size_t size = a.size() - d.size() + 1;
+		const limb_t inverse = limb_inverse(d[0]);
+		limb_vector quotient(size);
+
+		// Only the bottom limbs of a ever matter, anything past the quotient size cancels out by definition.
+		for (size_t i = 0; i < size; i++)
+		{
+			quotient[i] = a[i] * inverse;
+
+			const size_t n = std::min(d.size(), size - i);
+			limb_t borrow = limbs_submul_1(a.data() + i, d.data(), n, quotient[i]);
+
+			for (size_t j = i + n; j < size && borrow != 0; j++)
+			{
+				const limb_t current = a[j];
+				a[j] = current - borrow;
+				borrow = (a[j] > current);
+			}
+		}
+
+		mag_normalize(quotient);
+		return quotient;
+	}
+
+	// Multiplies a bunch of magnitudes together, pairing up neighbours so both sides of every multiplication are about the same size.
+	// Consumes the factors in the range.
+	static limb_vector mag_product(std::vector<limb_vector>& factors, size_t begin, size_t end)
+	{
+		if (end - begin == 0)
+		{
+			return { 1 };
+		}
+		else if (end - begin == 1)
+		{
+			return std::move(factors[begin]);
+		}
+
+		const size_t middle = begin + (end - begin) / 2;
+		return mag_mul(mag_product(factors, begin, middle), mag_product(factors, middle, end));
+	}
+
+	// Adds up magnitudes without propagating carries until the end. columns[i] is the sum of every limb i, wrapped around,
+	// and carries[i] counts how many times column i - 1 wrapped around, which can't overflow before there are 2^64 terms.
+	struct column_sum
+	{
+		limb_vector columns;
+		limb_vector carries = limb_vector(1, 0);
+
+		// Makes room for terms of up to n limbs.
+		void reserve(size_t n)
+		{
+			if (columns.size() < n)
+			{
+				columns.resize(n, 0);
+				carries.resize(n + 1, 0);
+			}
+		}
+
+		void add(const limb_t* limbs, size_t n)
+		{
+			reserve(n);
+
+			for (size_t i = 0; i < n; i++)
+			{
+				columns[i] += limbs[i];
+				carries[i + 1] += (columns[i] < limbs[i]);
+			}
+		}
+
+		// Propagates all the carries in a single pass and returns the normalized total.
+		limb_vector finish()
+		{
+			columns.resize(carries.size() + 1, 0);
+			limbs_add(columns.data(), columns.data(), columns.size(), carries.data(), carries.size());
+			mag_normalize(columns);
+
+			return std::move(columns);
+		}
+	};
+
+	// Returns first * (first + step) * ... for count terms, none of which may be 0.
+	static limb_vector mag_range_product(uint64_t first, uint64_t count, uint64_t step)
+	{
+		// Small terms get packed into as few limbs as possible before the tree gets to them.
+		std::vector<limb_vector> factors;
+		limb_t packed = 1;
+
+		for (uint64_t i = 0; i < count; i++, first += step)
+		{
+			limb_t high;
+			const limb_t low = mul_wide(packed, first, high);
+
+			if (high != 0)
+			{
+				factors.push_back({ packed });
+				packed = first;
+			}
+			else
+			{
+				packed = low;
+			}
+		}
+
+		factors.push_back({ packed });
+		return mag_product(factors, 0, factors.size());
+	}
+
+	// Returns n! with all factors of two removed.
+	static limb_vector mag_odd_factorial(uint64_t n)
+	{
+		// The odd part of n! is the product of P(n >> i) for every i, where P(m) is the product of all odd numbers up to m.
+		// Going from the top, P(n >> i) is P(n >> (i + 1)) times the odd numbers in (n >> (i + 1), n >> i].
+		limb_vector result = { 1 };
+		limb_vector odd_product = { 1 };
+
+		for (int i = std::bit_width(n) - 1; i >= 0; i--)
+		{
+			const uint64_t last = n >> i;
+			const uint64_t first = ((last >> 1) + 1) | 1;
+
+			if (first <= last)
+			{
+				odd_product = mag_mul(odd_product, mag_range_product(first, (last - first) / 2 + 1, 2));
+				result = mag_mul(result, odd_product);
+			}
+		}
+
+		return result;
+	}
+
+	// Stores F(n) in f and F(n + 1) in g.
+	static void mag_fibonacci(uint64_t n, limb_vector& f, limb_vector& g)
+	{
+		f = {};
+		g = { 1 };
+
+		for (int i = std::bit_width(n) - 1; i >= 0; i--)
+		{
+			// F(2k) = F(k) * (2 * F(k + 1) - F(k)), F(2k + 1) = F(k)^2 + F(k + 1)^2
+			limb_vector twice = g;
+			mag_shift_left(twice, 1);
+
+			limb_vector even = mag_mul(f, mag_sub(twice, f));
+			limb_vector odd = mag_add(mag_mul(f, f), mag_mul(g, g));
+
+			if ((n >> i) & 1)
+			{
+				g = mag_add(even, odd);
+				f = std::move(odd);
+			}
+			else
+			{
+				f = std::move(even);
+				g = std::move(odd);
+			}
+		}
+	}
+
+	// Odd primes below this are used for trial division and sieving.
+	const static limb_t small_prime_limit = 4096;
+
+	// Returns the odd primes below small_prime_limit, sieved the first time they're asked for.
+	static const std::vector<limb_t>& small_primes()
+	{
+		static const std::vector<limb_t> primes = []()
+		{
+			std::vector<bool> composite(small_prime_limit, false);
+			std::vector<limb_t> result;
+
+			for (limb_t i = 3; i < small_prime_limit; i += 2)
+			{
+				if (!composite[i])
+				{
+					result.push_back(i);
+
+					for (limb_t j = i * i; j < small_prime_limit; j += 2 * i)
+					{
+						composite[j] = true;
+					}
+				}
+			}
+
+			return result;
+		}();
+
+		return primes;
+	}
+
+	// Calls function(prime, a % prime) for every small prime until it returns false.
+	// The primes are grouped so each group's product fits in a limb, that way it's one pass over a per group instead of one per prime.
+	template<typename Function>
+	static void mag_small_prime_residues(const limb_vector& a, Function function)
+	{
+		const std::vector<limb_t>& primes = small_primes();
+		size_t begin = 0;
+
+		while (begin < primes.size())
+		{
+			limb_t product = primes[begin];
+			size_t end = begin + 1;
+
+			for (; end < primes.size(); end++)
+			{
+				limb_t high;
+				const limb_t next = mul_wide(product, primes[end], high);
+
+				if (high != 0)
+				{
+					break;
+				}
+
+				product = next;
+			}
+
+			const limb_t residue = limbs_mod_1(a.data(), a.size(), product);
+
+			for (size_t i = begin; i < end; i++)
+			{
+				if (!function(primes[i], residue % primes[i]))
+				{
+					return;
+				}
+			}
+
+			begin = end;
+		}
+	}
+
+	// Settles whatever can be settled without modular exponentiation. Returns nothing if it's still undecided,
+	// in which case n is odd, bigger than small_prime_limit^2 and has no small factors.
+	static std::optional<bool> mag_trial_division(const limb_vector& n)
+	{
+		if (n.empty() || (n.size() == 1 && n[0] < 2))
+		{
+			return false;
+		}
+		else if (n.size() == 1 && n[0] < small_prime_limit)
+		{
+			const std::vector<limb_t>& primes = small_primes();
+			return n[0] == 2 || std::binary_search(primes.begin(), primes.end(), n[0]);
+		}
+		else if ((n[0] & 1) == 0)
+		{
+			return false;
+		}
+
+		bool divisible = false;
+
+		mag_small_prime_residues(n, [&divisible](limb_t, limb_t residue)
+		{
+			divisible = (residue == 0);
+			return !divisible;
+		});
+
+		if (divisible)
+		{
+			return false;
+		}
+		else if (n.size() == 1 && n[0] < small_prime_limit * small_prime_limit)
+		{
+			return true;
+		}
+
+		return std::nullopt;
+	}
+
+	// Numbers with magnitudes up to this many bits get serialized as a single zigzag varint.
+	const static size_t wire_small_bits = 62;
+
+	// Bits needed for the magnitude of the number, 0 for 0.
+	size_t magnitude_bit_length() const noexcept
+	{
+		const size_t bits = bit_length();
+
+		// -2^k has a bit length of k, but its magnitude needs k + 1 bits.
+		return (is_negative() && countr_zero() == bits ? bits + 1 : bits);
+	}
+
+	// Returns the 64 bits of the two's complement value starting at bit position, sign extended past the top.
+	limb_t raw_bits_at(size_t position) const noexcept
+	{
+		const size_t first = position / byte_bits;
+		const unsigned int offset = position % byte_bits;
+		const uint8_t fill = (is_negative() ? UINT8_MAX : 0);
+
+		limb_t bits = 0;
+
+		for (size_t i = 0; i < limb_bytes; i++)
+		{
+			bits |= static_cast<limb_t>(first + i < value.size() ? value[first + i] : fill) << (byte_bits * i);
+		}
+
+		if (offset != 0)
+		{
+			const limb_t next = (first + limb_bytes < value.size() ? value[first + limb_bytes] : fill);
+			bits = (bits >> offset) | (next << (limb_bits - offset));
+		}
+
+		return bits;
+	}
+
+	// Builds a number out of the integer part of a float by taking the mantissa as an integer and shifting it by the exponent.
+	template<typename FloatingPoint>
+	static LargeInt from_float(FloatingPoint val, size_t max_size)
+	{
+		constexpr int digits = std::numeric_limits<FloatingPoint>::digits;
+		static_assert(digits < 2 * limb_bits, "LargeInt float conversion needs the mantissa to fit in two limbs.");
+
+		if (std::isinf(val))
+		{
+			throw invalid_float_conversion("Cannot convert infinity to LargeInt.");
+		}
+		else if (std::isnan(val))
+		{
+			throw invalid_float_conversion("Cannot convert NaN to LargeInt.");
+		}
+
+		const bool negative = std::signbit(val);
+		val = std::trunc(std::abs(val));
+
+		if (val == 0)
+		{
+			return LargeInt(0, max_size);
+		}
+
+		// val = fraction * 2^exponent with 0.5 <= fraction < 1, so fraction * 2^digits is the mantissa as a whole number.
+		int exponent;
+		const FloatingPoint mantissa = std::ldexp(std::frexp(val, &exponent), digits);
+		const FloatingPoint high = std::trunc(std::ldexp(mantissa, -static_cast<int>(limb_bits)));
+		const FloatingPoint low = mantissa - std::ldexp(high, static_cast<int>(limb_bits));
+
+		limb_vector limbs = { static_cast<limb_t>(low), static_cast<limb_t>(high) };
+		mag_normalize(limbs);
+
+		// Truncating first means anything shifted out on the right is 0.
+		if (exponent >= digits)
+		{
+			mag_shift_left(limbs, static_cast<size_t>(exponent - digits));
+		}
+		else
+		{
+			mag_shift_right(limbs, static_cast<size_t>(digits - exponent));
+		}
+
+		return from_limbs(std::move(limbs), negative, max_size);
+	}
+
+	// Writes the lowest count bytes of the magnitude, little endian, to an output iterator of bytes.
+	// Negative numbers are stored as two's complement, so they get negated a byte at a time on the way out instead of being copied first.
+	template<typename OutputIt>
+	OutputIt write_magnitude_bytes(OutputIt out, size_t count) const
+	{
+		const bool negative = is_negative();
+		uint8_t carry = 1;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			uint8_t byte = (i < value.size() ? value[i] : (negative ? UINT8_MAX : 0));
+
+			if (negative)
+			{
+				const uint8_t flipped = static_cast<uint8_t>(~byte);
+				byte = static_cast<uint8_t>(flipped + carry);
+				carry = (carry != 0 && flipped == UINT8_MAX ? 1 : 0);
+			}
+
+			*out++ = byte;
+		}
+
+		return out;
+	}
+
+	// Builds a number out of count little endian magnitude bytes and a sign, copying them straight into the storage.
+	static LargeInt from_magnitude_bytes(const uint8_t* bytes, size_t count, bool negative)
+	{
+		// One extra byte for the sign bit, then negated in place if it needs to be.
+		LargeInt new_val;
+		new_val.value.resize(count + 1);
+
+		if (count > 0)
+		{
+			std::memcpy(new_val.value.data(), bytes, count);
+		}
+
+		if (negative)
+		{
+			bytes_negate(new_val.value.data(), new_val.value.size());
+		}
+
+		new_val.trim_size();
+		return new_val;
+	}
+
+	// The varint header for a number that fits in wire_small_bits.
+	uint64_t wire_small_header() const noexcept
+	{
+		limb_t magnitude = 0;
+		copy_limbs(&magnitude);
+
+		const uint64_t zigzag = (is_negative() ? 2 * magnitude - 1 : 2 * magnitude);
+		return zigzag << 1;
+	}
+
+	// The varint header for a number with a magnitude of limbs limbs.
+	uint64_t wire_large_header(size_t limbs) const noexcept
+	{
+		return (((static_cast<uint64_t>(limbs) << 1) | (is_negative() ? 1 : 0)) << 1) | 1;
+	}
+
+	static size_t varint_size(uint64_t num) noexcept
+	{
+		return std::max<size_t>((std::bit_width(num) + 6) / 7, 1);
+	}
+
+	// Writes num 7 bits at a time from the bottom, with the top bit of every byte but the last set.
+	template<typename OutputIt>
+	static OutputIt write_varint(OutputIt out, uint64_t num)
+	{
+		while (num >= 0x80)
+		{
+			*out++ = static_cast<uint8_t>(num | 0x80);
+			num >>= 7;
+		}
+
+		*out++ = static_cast<uint8_t>(num);
+		return out;
+	}
+
+	// Reads a varint off the front of data and moves data past it.
+	// Throws invalid_serialization if it's cut off or doesn't fit in 64 bits.
+	static uint64_t read_varint(std::span<const uint8_t>& data)
+	{
+		uint64_t num = 0;
+
+		for (size_t i = 0; i < data.size() && i < 10; i++)
+		{
+			const uint8_t byte = data[i];
+
+			if (i == 9 && byte > 1)
+			{
+				break;
+			}
+
+			num |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+
+			if ((byte & 0x80) == 0)
+			{
+				data = data.subspan(i + 1);
+				return num;
+			}
+		}
+
+		throw invalid_serialization("Serialized LargeInt has a cut off or overlong header.");
+	}
+
+	// to_chars() converts numbers up to this many limbs on the stack.
+	const static size_t chars_stack_limbs = 256;
+
+	// Below this many limbs converting to or from digits is done with plain single limb multiplications or divisions,
+	// above it the number is split up (or glued together) with powers of the base.
+	const static size_t string_basecase_limbs = 32;
+
+	// Radix powers up to this size (in limbs) stay cached between conversions, bigger ones are freed after each.
+	const static size_t radix_cache_limbs = 16384;
+
+	// Returns the value of a digit character in bases up to 36, or UINT8_MAX if it isn't one.
+	static uint8_t digit_value(char c) noexcept
+	{
+		static constexpr std::array<uint8_t, 256> values = []()
+		{
+			std::array<uint8_t, 256> table = {};
+			table.fill(UINT8_MAX);
+
+			for (uint8_t i = 0; i < 10; i++)
+			{
+				table['0' + i] = i;
+			}
+
+			for (uint8_t i = 0; i < 26; i++)
+			{
+				table['a' + i] = static_cast<uint8_t>(i + 10);
+				table['A' + i] = static_cast<uint8_t>(i + 10);
+			}
+
+			return table;
+		}();
+
+		return values[static_cast<unsigned char>(c)];
+	}
+
+	// Returns the most digits of the base that always fit in a limb, and the base to the power of that.
+	static std::pair<size_t, limb_t> digits_per_limb(limb_t base) noexcept
+	{
+		size_t digits = 1;
+		limb_t power = base;
+
+		while (power <= std::numeric_limits<limb_t>::max() / base)
+		{
+			power *= base;
+			digits++;
+		}
+
+		return std::make_pair(digits, power);
+	}
+
+	// Reads a few digits (no more than fit in a limb) into a limb.
+	// Throws invalid_string_conversion if a character isn't a digit in the base.
+	static limb_t string_chunk_value(std::string_view digits, limb_t base)
+	{
+		limb_t result = 0;
+
+		for (char c : digits)
+		{
+			const uint8_t digit = digit_value(c);
+
+			if (digit >= base)
+			{
+				throw invalid_string_conversion("Cannot convert a string with invalid digits to LargeInt.");
+			}
+
+			result = result * base + digit;
+		}
+
+		return result;
+	}
+
+	// Converts a string of digits (no sign) into a normalized magnitude.
+	// Throws invalid_string_conversion if a character isn't a digit in the base.
+	static limb_vector mag_from_digits(std::string_view digits, limb_t base)
+	{
+		if (std::has_single_bit(base))
+		{
+			return mag_from_pow2_digits(digits, base);
+		}
+
+		const auto [chunk_digits, chunk_base] = digits_per_limb(base);
+		const size_t block_digits = chunk_digits * string_basecase_limbs;
+
+		// Blocks of block_digits from the least significant end (the last one might be short), each read with multiply-adds.
+		std::vector<limb_vector> parts((digits.size() + block_digits - 1) / block_digits);
+
+		for (size_t i = 0; i < parts.size(); i++)
+		{
+			const size_t end = digits.size() - i * block_digits;
+			const size_t begin = (end > block_digits ? end - block_digits : 0);
+			const std::string_view block = digits.substr(begin, end - begin);
+
+			// The first chunk takes whatever doesn't divide evenly, so the rest are all full.
+			const size_t first = (block.size() - 1) % chunk_digits + 1;
+			limb_vector& part = parts[i];
+			part.reserve(string_basecase_limbs + 1);
+			part.push_back(string_chunk_value(block.substr(0, first), base));
+
+			for (size_t position = first; position < block.size(); position += chunk_digits)
+			{
+				const limb_t high = limbs_mul_1(part.data(), part.data(), part.size(), chunk_base);
+				const limb_t carry = limbs_add_1(part.data(), part.data(), part.size(), string_chunk_value(block.substr(position, chunk_digits), base));
+
+				if (high + carry != 0)
+				{
+					part.push_back(high + carry);
+				}
+			}
+
+			mag_normalize(part);
+		}
+
+		if (parts.empty())
+		{
+			return {};
+		}
+
+		// Every full block is worth chunk_base^string_basecase_limbs, and each level up squares that.
+		limb_vector power = { 1 };
+
+		for (size_t i = 0; i < string_basecase_limbs; i++)
+		{
+			power.push_back(limbs_mul_1(power.data(), power.data(), power.size(), chunk_base));
+			mag_normalize(power);
+		}
+
+		while (parts.size() > 1)
+		{
+			for (size_t i = 0; i < parts.size() / 2; i++)
+			{
+				parts[i] = mag_add(mag_mul(parts[2 * i + 1], power), parts[2 * i]);
+			}
+
+			if (parts.size() % 2 == 1)
+			{
+				parts[parts.size() / 2] = std::move(parts.back());
+			}
+
+			parts.resize((parts.size() + 1) / 2);
+
+			if (parts.size() > 1)
+			{
+				power = mag_mul(power, power);
+			}
+		}
+
+		return std::move(parts[0]);
+	}
+
+	// Turns digits into a magnitude as they arrive, most significant first, without keeping more than a block of them around.
+	// Every full block is converted straight away, and the converted blocks are merged like a binary counter: whenever the last two
+	// cover the same number of blocks they become one. That's the same balanced tree mag_from_digits() builds, just grown from the other end,
+	// and at any point it only holds the limbs of the number so far plus the powers of the base used to merge them.
+	class digit_reader
+	{
+	public:
+		explicit digit_reader(limb_t base) : base(base), block_digits(digits_per_limb(base).first * string_basecase_limbs)
+		{}
+
+		// Number of digits push() wants at a time.
+		size_t block_size() const noexcept
+		{
+			return block_digits;
+		}
+
+		// Adds the next block of digits. Every block but the last one has to be exactly block_size() digits long.
+		void push(std::string_view digits)
+		{
+			if (digits.size() < block_digits)
+			{
+				tail_digits = digits.size();
+				tail = mag_from_digits(digits, base);
+				return;
+			}
+
+			parts.push_back({ mag_from_digits(digits, base), 0 });
+
+			while (parts.size() > 1 && parts[parts.size() - 2].level == parts.back().level)
+			{
+				part low = std::move(parts.back());
+				parts.pop_back();
+
+				part& high = parts.back();
+				high.value = mag_add(shift_up(high.value, high.level), low.value);
+				high.level++;
+			}
+		}
+
+		// Returns everything pushed so far as one magnitude.
+		limb_vector finish()
+		{
+			// From the least significant end, each part goes on top of what's been put together already.
+			limb_vector result = std::move(tail);
+			limb_vector scale = { 1 };
+
+			for (size_t i = 0; i < tail_digits; i++)
+			{
+				scale.push_back(limbs_mul_1(scale.data(), scale.data(), scale.size(), base));
+				mag_normalize(scale);
+			}
+
+			for (size_t i = parts.size(); i > 0; i--)
+			{
+				result = mag_add(mag_mul(parts[i - 1].value, scale), result);
+
+				if (i > 1)
+				{
+					scale = shift_up(scale, parts[i - 1].level);
+				}
+			}
+
+			return result;
+		}
+
+	private:
+		// A merged run of 2^level blocks.
+		struct part
+		{
+			limb_vector value;
+			size_t level;
+		};
+
+		limb_t base;
+		size_t block_digits;
+		std::vector<part> parts;
+		std::vector<limb_vector> powers;	// base^(block_digits * 2^i)
+		limb_vector tail;
+		size_t tail_digits = 0;
+
+		// Returns a * base^(block_digits * 2^level).
+		limb_vector shift_up(const limb_vector& a, size_t level)
+		{
+			if (std::has_single_bit(base))
+			{
+				limb_vector result = a;
+				mag_shift_left(result, (block_digits << level) * std::countr_zero(base));
+				return result;
+			}
+
+			while (powers.size() <= level)
+			{
+				if (powers.empty())
+				{
+					limb_vector power = { 1 };
+
+					for (size_t i = 0; i < string_basecase_limbs; i++)
+					{
+						power.push_back(limbs_mul_1(power.data(), power.data(), power.size(), digits_per_limb(base).second));
+						mag_normalize(power);
+					}
+
+					powers.push_back(std::move(power));
+				}
+				else
+				{
+					powers.push_back(mag_mul(powers.back(), powers.back()));
+				}
+			}
+
+			return mag_mul(a, powers[level]);
+		}
+	};
+
+	// base^(digits_per_limb(base) * 2^i) and its reciprocal, for splitting numbers in half when turning them into digits.
+	struct radix_power
+	{
+		limb_vector power;
+		limb_vector reciprocal;		// floor(2^(128 * power.size()) / power)
+	};
+
+	// Returns at least the first count radix powers for the base. They're cached per thread,
+	// but only up to radix_cache_limbs: trim_radix_powers() drops anything bigger once the conversion is done.
+	static std::vector<radix_power>& radix_powers(limb_t base, size_t count)
+	{
+		static thread_local std::vector<radix_power> cache[37];
+		std::vector<radix_power>& powers = cache[base];
+
+		while (powers.size() < count)
+		{
+			radix_power next;
+			next.power = (powers.empty() ? limb_vector{ digits_per_limb(base).second } : mag_mul(powers.back().power, powers.back().power));
+			next.reciprocal = mag_reciprocal(next.power);
+			powers.push_back(std::move(next));
+		}
+
+		return powers;
+	}
+
+	// Frees the radix powers that are too big to keep around, or printing one huge number would pin them to the thread for good.
+	static void trim_radix_powers(std::vector<radix_power>& powers) noexcept
+	{
+		while (!powers.empty() && powers.back().power.size() > radix_cache_limbs)
+		{
+			powers.pop_back();
+		}
+	}
+
+	// Returns floor(2^(128 * n) / d) for a normalized d of n limbs.
+	// Newton's method starting from the reciprocal of the top half of d, so it only costs a few multiplications instead of a long division.
+	static limb_vector mag_reciprocal(const limb_vector& d)
+	{
+		const size_t n = d.size();
+
+		limb_vector target(2 * n + 1);
+		target.back() = 1;
+
+		if (n <= karatsuba_threshold)
+		{
+			return mag_divmod(target, d, nullptr);
+		}
+
+		// Rounding the top half up keeps the estimate at or below the real thing, which Newton's method then never overshoots.
+		const size_t high = (n + 1) / 2;
+		const limb_vector top = mag_add(limb_vector(d.end() - high, d.end()), { 1 });
+		limb_vector x;
+
+		if (top.size() > high)
+		{
+			// The top half was all ones, 2^(128 * high) / 2^(64 * high) is just 2^(64 * high)
+			x.assign(high + 1, 0);
+			x.back() = 1;
+		}
+		else
+		{
+			x = mag_reciprocal(top);
+		}
+
+		mag_shift_left(x, (n - high) * limb_bits);
+
+		// Each step only needs as many limbs of x and the error as the error is longer than d, and the error after it is just error - d * step.
+		limb_vector error = mag_sub(target, mag_mul(d, x));
+
+		while (mag_compare(error, d) >= 0)
+		{
+			// x += x * error / 2^(128 * n), or at least 1 once that rounds down to nothing
+			const size_t keep = error.size() - n + 2;
+			const size_t drop_x = (x.size() > keep ? x.size() - keep : 0);
+			const size_t drop_error = (error.size() > keep ? error.size() - keep : 0);
+
+			limb_vector step = mag_mul(limb_vector(x.begin() + drop_x, x.end()), limb_vector(error.begin() + drop_error, error.end()));
+			mag_shift_right(step, (2 * n - drop_x - drop_error) * limb_bits);
+
+			if (step.empty())
+			{
+				step = { 1 };
+			}
+
+			error = mag_sub(error, mag_mul(d, step));
+			x = mag_add(x, step);
+		}
+
+		return x;
+	}
+
+	// Divides a by a radix power (Barrett reduction), where a < power^2. Returns the quotient and stores the remainder.
+	static limb_vector mag_divmod_radix(const limb_vector& a, const radix_power& divisor, limb_vector& remainder)
+	{
+		const size_t n = divisor.power.size();
+
+		if (mag_compare(a, divisor.power) < 0)
+		{
+			remainder = a;
+			return {};
+		}
+
+		// Estimating off the top of a and the reciprocal is at most 2 short (HAC 14.42)
+		limb_vector quotient = mag_mul(limb_vector(a.begin() + (n - 1), a.end()), divisor.reciprocal);
+		mag_shift_right(quotient, (n + 1) * limb_bits);
+		remainder = mag_sub(a, mag_mul(quotient, divisor.power));
+
+		while (mag_compare(remainder, divisor.power) >= 0)
+		{
+			remainder = mag_sub(remainder, divisor.power);
+			quotient = mag_add(quotient, { 1 });
+		}
+
+		return quotient;
+	}
+
+	// Writes the count lowest digits of a limb ending right before end.
+	static void write_limb_digits(limb_t a, limb_t base, size_t count, char* end) noexcept
+	{
+		constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+		// Separate so the compiler can turn the divisions into multiplications.
+		if (base == 10)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				*--end = static_cast<char>('0' + a % 10);
+				a /= 10;
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				*--end = digit_chars[a % base];
+				a /= base;
+			}
+		}
+	}
+
+	// Writes a, which must be below powers[level] (or base^(digits_per_limb << level) at the top), as exactly digits_per_limb << level digits.
+	// Splits in half by the radix powers until the pieces are small enough for single limb divisions.
+	static void mag_write_digits(const limb_vector& a, limb_t base, const std::vector<radix_power>& powers, size_t level, char* out)
+	{
+		const auto [chunk_digits, chunk_base] = digits_per_limb(base);
+		const size_t width = chunk_digits << level;
+
+		if (a.size() <= string_basecase_limbs || level == 0)
+		{
+			limb_vector quotient = a;
+			char* end = out + width;
+
+			while (!quotient.empty())
+			{
+				const limb_t remainder = limbs_divrem_1(quotient.data(), quotient.data(), quotient.size(), chunk_base);
+				mag_normalize(quotient);
+
+				write_limb_digits(remainder, base, chunk_digits, end);
+				end -= chunk_digits;
+			}
+
+			std::fill(out, end, '0');
+			return;
+		}
+
+		limb_vector remainder;
+		const limb_vector quotient = mag_divmod_radix(a, powers[level - 1], remainder);
+
+		mag_write_digits(quotient, base, powers, level - 1, out);
+		mag_write_digits(remainder, base, powers, level - 1, out + width / 2);
+	}
+
+	// Converts a normalized magnitude into a string of digits, with a minus in front if it's negative.
+	static std::string mag_to_string(const limb_vector& a, limb_t base, bool negative)
+	{
+		if (a.empty())
+		{
+			return "0";
+		}
+
+		if (std::has_single_bit(base))
+		{
+			return mag_to_pow2_string(a, base, negative);
+		}
+
+		// Every radix power is at least 2^(bits_per_chunk << level), so find the first one that's definitely bigger than a.
+		const auto [chunk_digits, chunk_base] = digits_per_limb(base);
+		const size_t bits_per_chunk = std::bit_width(chunk_base) - 1;
+		const size_t bits = mag_bit_length(a);
+		size_t level = 0;
+
+		while ((bits_per_chunk << level) < bits)
+		{
+			level++;
+		}
+
+		// Written zero padded to the width of the power, then the padding is cut off.
+		const size_t sign = (negative ? 1 : 0);
+		std::string output(sign + (chunk_digits << level), '0');
+		std::vector<radix_power>& powers = radix_powers(base, a.size() > string_basecase_limbs ? level : 0);
+
+		try
+		{
+			mag_write_digits(a, base, powers, level, output.data() + sign);
+		}
+		catch (...)
+		{
+			trim_radix_powers(powers);
+			throw;
+		}
+
+		trim_radix_powers(powers);
+
+		output.erase(sign, output.find_first_not_of('0', sign) - sign);
+
+		if (negative)
+		{
+			output[0] = '-';
+		}
+
+		return output;
+	}
+
+	// Converts a string of digits in a power of two base (no sign) into a normalized magnitude, without any arithmetic.
+	// Throws invalid_string_conversion if a character isn't a digit in the base.
+	static limb_vector mag_from_pow2_digits(std::string_view digits, limb_t base)
+	{
+		const size_t bits_per_digit = std::countr_zero(base);
+		limb_vector result((digits.size() * bits_per_digit + limb_bits - 1) / limb_bits);
+		uint8_t invalid = 0;
+
+		if (limb_bits % bits_per_digit == 0)
+		{
+			// Every limb is a whole number of digits, so they can be shifted in one after the other.
+			const size_t limb_digits = limb_bits / bits_per_digit;
+			size_t end = digits.size();
+
+			for (limb_t& limb : result)
+			{
+				const size_t begin = (end > limb_digits ? end - limb_digits : 0);
+
+				for (size_t i = begin; i < end; i++)
+				{
+					const uint8_t digit = digit_value(digits[i]);
+					invalid |= static_cast<uint8_t>(digit >= base);
+					limb = (limb << bits_per_digit) | (digit & (base - 1));
+				}
+
+				end = begin;
+			}
+		}
+		else
+		{
+			// Octal and base 32 digits straddle limbs every so often.
+			size_t position = 0;
+
+			for (auto c = digits.rbegin(); c != digits.rend(); c++, position += bits_per_digit)
+			{
+				const uint8_t digit = digit_value(*c);
+				invalid |= static_cast<uint8_t>(digit >= base);
+
+				const limb_t bits = digit & (base - 1);
+				const size_t shift = position % limb_bits;
+				result[position / limb_bits] |= bits << shift;
+
+				if (shift + bits_per_digit > limb_bits)
+				{
+					result[position / limb_bits + 1] |= bits >> (limb_bits - shift);
+				}
+			}
+		}
+
+		if (invalid != 0)
+		{
+			throw invalid_string_conversion("Cannot convert a string with invalid digits to LargeInt.");
+		}
+
+		mag_normalize(result);
+		return result;
+	}
+
+	// Writes the 16 hex digits of a limb, most significant first.
+	static void write_limb_hex(limb_t a, char* out) noexcept
+	{
+		#if defined (LARGE_VARIABLES_SSE2)
+		// Splits every byte into its two nibbles side by side, reverses the byte pairs and then maps 0-15 onto 0-9a-f all at once.
+		const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&a));
+		const __m128i low_nibble = _mm_set1_epi8(0x0f);
+		__m128i nibbles = _mm_unpacklo_epi8(_mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble), _mm_and_si128(bytes, low_nibble));
+		nibbles = _mm_shuffle_epi32(nibbles, 0x4e);
+		nibbles = _mm_shufflehi_epi16(_mm_shufflelo_epi16(nibbles, 0x1b), 0x1b);
+
+		const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters));
+		#else
+		static constexpr std::array<char, 512> pairs = []()
+		{
+			constexpr char digit_chars[] = "0123456789abcdef";
+			std::array<char, 512> table = {};
+
+			for (size_t i = 0; i < 256; i++)
+			{
+				table[2 * i] = digit_chars[i >> 4];
+				table[2 * i + 1] = digit_chars[i & 0x0f];
+			}
+
+			return table;
+		}();
+
+		for (size_t i = 8; i > 0; i--, a >>= 8)
+		{
+			std::memcpy(out + 2 * (i - 1), &pairs[2 * (a & 0xff)], 2);
+		}
+		#endif
+	}
+
+	// Writes the lowest end - begin digits of a magnitude in a power of two base into [begin, end) by regrouping its bits.
+	static void limbs_write_pow2_digits(const limb_t* a, size_t n, limb_t base, char* begin, char* end) noexcept
+	{
+		constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuv";
+
+		const size_t bits_per_digit = std::countr_zero(base);
+		size_t next = 0;
+
+		if (base == 16)
+		{
+			// Whole limbs go 16 digits at a time, only the top one has to stop early.
+			for (; next + 1 < n && static_cast<size_t>(end - begin) >= 16; next++)
+			{
+				end -= 16;
+				write_limb_hex(a[next], end);
+			}
+		}
+
+		// Digits get cut off the bottom of a small buffer of bits, topping it up from the next limb whenever it runs dry.
+		limb_t buffer = 0;
+		size_t buffered = 0;
+
+		while (end != begin)
+		{
+			limb_t digit;
+
+			if (buffered >= bits_per_digit)
+			{
+				digit = buffer & (base - 1);
+				buffer >>= bits_per_digit;
+				buffered -= bits_per_digit;
+			}
+			else
+			{
+				const limb_t limb = (next < n ? a[next++] : 0);
+				digit = (buffer | (limb << buffered)) & (base - 1);
+				buffer = limb >> (bits_per_digit - buffered);
+				buffered += limb_bits - bits_per_digit;
+			}
+
+			*--end = digit_chars[digit];
+		}
+	}
+
+	// Converts a normalized magnitude into a string of digits in a power of two base, with a minus in front if it's negative.
+	static std::string mag_to_pow2_string(const limb_vector& a, limb_t base, bool negative)
+	{
+		const size_t bits_per_digit = std::countr_zero(base);
+		const size_t sign = (negative ? 1 : 0);
+		std::string output(sign + (mag_bit_length(a) + bits_per_digit - 1) / bits_per_digit, '-');
+
+		limbs_write_pow2_digits(a.data(), a.size(), base, output.data() + sign, output.data() + output.size());
+
+		return output;
+	}
+
+	// Pulls a full limb of random bits out of a generator, however many bits it gives per call.
+	template<typename URBG>
+	static limb_t random_limb(URBG& urbg)
+	{
+		using generator = std::remove_reference_t<URBG>;
+		constexpr auto range = generator::max() - generator::min();
+
+		if constexpr (range == std::numeric_limits<decltype(range)>::max() || (range != 0 && ((range + 1) & range) == 0))
+		{
+			// Every call gives a whole number of bits, so they can just be glued together.
+			constexpr int bits = std::bit_width(static_cast<limb_t>(range));
+			limb_t result = static_cast<limb_t>(urbg() - generator::min());
+
+			for (int filled = bits; filled < limb_bits; filled += bits)
+			{
+				result = (result << (bits % limb_bits)) | static_cast<limb_t>(urbg() - generator::min());
+			}
+
+			return result;
+		}
+		else
+		{
+			return std::uniform_int_distribution<limb_t>()(urbg);
+		}
+	}
+
+	// Returns a uniformly distributed random normalized magnitude in [0, limit), for a normalized limit that isn't zero.
+	template<typename URBG>
+	static limb_vector mag_random_below(const limb_vector& limit, URBG& urbg)
+	{
+		// Rejection sampling, but from the top limb down: as soon as a limb comes out below the bound's the rest can be anything,
+		// and if it comes out above it's tossed right there. With the top limb masked to the bound's width it takes less than 2 tries on average.
+		const unsigned int top_bits = mag_bit_length(limit) % limb_bits;
+		const limb_t top_mask = (top_bits == 0 ? ~limb_t(0) : (limb_t(1) << top_bits) - 1);
+		limb_vector limbs(limit.size());
+		size_t i = limbs.size() - 1;
+		bool below = false;
+
+		while (true)
+		{
+			limbs[i] = random_limb(urbg) & (i == limbs.size() - 1 ? top_mask : ~limb_t(0));
+
+			if (!below && limbs[i] > limit[i])
+			{
+				// Start over
+				i = limbs.size() - 1;
+				continue;
+			}
+
+			below = below || limbs[i] < limit[i];
+
+			if (i == 0)
+			{
+				if (below)
+				{
+					break;
+				}
+
+				// Rolled exactly the bound
+				i = limbs.size() - 1;
+				continue;
+			}
+
+			i--;
+		}
+
+		mag_normalize(limbs);
+		return limbs;
+	}
+
+	// Montgomery arithmetic modulo an odd n. Values are stored as x * R mod n, where R = 2^(64 * size),
+	// which turns the reduction after a multiplication into a few multiply-adds instead of a division.
+	// Every value is exactly as many limbs as n (so not normalized) and always less than n.
+	struct montgomery_context
+	{
+		limb_vector modulus;
+		limb_t inverse;			// -1 / n mod 2^64
+		limb_vector one;		// R mod n
+		limb_vector r_squared;	// R^2 mod n
+
+		explicit montgomery_context(const limb_vector& n) : modulus(n), inverse(0 - limb_inverse(n[0]))
+		{
+			limb_vector power(n.size() + 1);
+			power.back() = 1;
+			mag_divmod(power, n, &one);
+			one.resize(n.size());
+
+			power.assign(2 * n.size() + 1, 0);
+			power.back() = 1;
+			mag_divmod(power, n, &r_squared);
+			r_squared.resize(n.size());
+		}
+
+		size_t size() const noexcept
+		{
+			return modulus.size();
+		}
+
+		// r = t / R mod n, where t has twice the size and is less than n * R. t gets trashed.
+		void reduce(limb_t* r, limb_t* t) const noexcept
+		{
+			const size_t n = size();
+
+			// Each step clears the bottom limb, the carry it makes is parked there and added in at the end.
+			for (size_t i = 0; i < n; i++)
+			{
+				t[i] = limbs_addmul_1(t + i, modulus.data(), n, t[i] * inverse);
+			}
+
+			if (limbs_add_n(r, t + n, t, n) != 0 || limbs_compare(r, modulus.data(), n) >= 0)
+			{
+				limbs_sub_n(r, r, modulus.data(), n);
+			}
+		}
+
+		// r = a * b / R mod n. r may be the same as a or b, scratch needs twice the size.
+		void mul(limb_t* r, const limb_t* a, const limb_t* b, limb_t* scratch) const
+		{
+			limbs_mul(scratch, a, size(), b, size());
+			reduce(r, scratch);
+		}
+
+		limb_vector mul(const limb_vector& a, const limb_vector& b) const
+		{
+			limb_vector result(size()), scratch(2 * size());
+			mul(result.data(), a.data(), b.data(), scratch.data());
+			return result;
+		}
+
+		limb_vector add(const limb_vector& a, const limb_vector& b) const
+		{
+			limb_vector result(size());
+
+			if (limbs_add_n(result.data(), a.data(), b.data(), size()) != 0 || limbs_compare(result.data(), modulus.data(), size()) >= 0)
+			{
+				limbs_sub_n(result.data(), result.data(), modulus.data(), size());
+			}
+
+			return result;
+		}
+
+		limb_vector sub(const limb_vector& a, const limb_vector& b) const
+		{
+			limb_vector result(size());
+
+			if (limbs_sub_n(result.data(), a.data(), b.data(), size()) != 0)
+			{
+				limbs_add_n(result.data(), result.data(), modulus.data(), size());
+			}
+
+			return result;
+		}
+
+		// a / 2 mod n
+		limb_vector half(const limb_vector& a) const
+		{
+			limb_vector result = a;
+			limb_t carry = 0;
+
+			if (a[0] & 1)
+			{
+				carry = limbs_add_n(result.data(), result.data(), modulus.data(), size());
+			}
+
+			limbs_rshift(result.data(), result.data(), size(), 1);
+			result.back() |= carry << (limb_bits - 1);
+			return result;
+		}
+
+		// Converts a normalized magnitude of any size into Montgomery form.
+		limb_vector to_form(const limb_vector& a) const
+		{
+			// Horner's rule a chunk of size() limbs at a time. Multiplying by R^2 does the conversion and
+			// the shift up by R in one go, and any chunk times R^2 is small enough to reduce, so there's no division anywhere.
+			limb_vector result(size()), chunk(size());
+
+			for (size_t end = (a.size() + size() - 1) / size() * size(); end != 0; end -= size())
+			{
+				const size_t begin = end - size();
+
+				std::fill(chunk.begin(), chunk.end(), 0);
+				std::copy(a.begin() + begin, a.begin() + std::min(end, a.size()), chunk.begin());
+				result = add(mul(result, r_squared), mul(chunk, r_squared));
+			}
+
+			return result;
+		}
+
+		// Converts a value in Montgomery form back into a normalized magnitude.
+		limb_vector from_form(const limb_vector& a) const
+		{
+			limb_vector result(size()), scratch(2 * size());
+			std::copy(a.begin(), a.end(), scratch.begin());
+			reduce(result.data(), scratch.data());
+			mag_normalize(result);
+			return result;
+		}
+
+		// base^exponent for a base in Montgomery form and a normalized exponent, 4 bits at a time.
+		limb_vector pow(const limb_vector& base, const limb_vector& exponent) const
+		{
+			const unsigned int window = 4;
+
+			limb_vector table[1 << window];
+			table[0] = one;
+			table[1] = base;
+
+			for (size_t i = 2; i < (1 << window); i++)
+			{
+				table[i] = mul(table[i - 1], base);
+			}
+
+			limb_vector result = one;
+			limb_vector scratch(2 * size());
+			bool started = false;
+
+			for (size_t bit = (mag_bit_length(exponent) + window - 1) / window * window; bit != 0; bit -= window)
+			{
+				if (started)
+				{
+					for (unsigned int i = 0; i < window; i++)
+					{
+						mul(result.data(), result.data(), result.data(), scratch.data());
+					}
+				}
+
+				const size_t position = bit - window;
+				const size_t digit = (exponent[position / limb_bits] >> (position % limb_bits)) & ((1 << window) - 1);
+
+				if (digit != 0)
+				{
+					mul(result.data(), result.data(), table[digit].data(), scratch.data());
+					started = true;
+				}
+			}
+
+			return result;
+		}
+	};
+
+	// One Miller-Rabin round: is the odd n > 3 a strong probable prime to the given base?
+	static bool mag_strong_probable_prime(const montgomery_context& context, const limb_vector& base)
+	{
+		// n - 1 = d * 2^s
+		limb_vector d = mag_sub(context.modulus, { 1 });
+		const size_t s = mag_countr_zero(d);
+		mag_shift_right(d, s);
+
+		const limb_vector minus_one = context.sub(limb_vector(context.size()), context.one);
+		limb_vector x = context.pow(context.to_form(base), d);
+
+		if (x == context.one || x == minus_one)
+		{
+			return true;
+		}
+
+		for (size_t i = 1; i < s; i++)
+		{
+			x = context.mul(x, x);
+
+			if (x == minus_one)
+			{
+				return true;
+			}
+			else if (x == context.one)
+			{
+				return false;
+			}
+		}
+
+		return false;
+	}
+
+	// Jacobi symbol (a / n) for two limbs, n odd.
+	static int limb_jacobi(limb_t a, limb_t n) noexcept
+	{
+		int result = 1;
+		a %= n;
+
+		while (a != 0)
+		{
+			const int zeros = std::countr_zero(a);
+			a >>= zeros;
+
+			// (2 / n) is -1 when n is 3 or 5 mod 8
+			if ((zeros & 1) && ((n & 7) == 3 || (n & 7) == 5))
+			{
+				result = -result;
+			}
+
+			// Quadratic reciprocity
+			if ((a & 3) == 3 && (n & 3) == 3)
+			{
+				result = -result;
+			}
+
+			std::swap(a, n);
+			a %= n;
+		}
+
+		return n == 1 ? result : 0;
+	}
+
+	// Jacobi symbol (a / n) for a small a and an odd n with more than one limb.
+	static int mag_jacobi(const limb_vector& n, int64_t a)
+	{
+		int result = 1;
+		limb_t x = (a < 0 ? 0 - static_cast<limb_t>(a) : static_cast<limb_t>(a));
+
+		// (-1 / n) is -1 when n is 3 mod 4
+		if (a < 0 && (n[0] & 3) == 3)
+		{
+			result = -result;
+		}
+
+		const int zeros = std::countr_zero(x);
+		x >>= zeros;
+
+		if ((zeros & 1) && ((n[0] & 7) == 3 || (n[0] & 7) == 5))
+		{
+			result = -result;
+		}
+
+		// Flip it around so everything else happens in a single limb
+		if ((x & 3) == 3 && (n[0] & 3) == 3)
+		{
+			result = -result;
+		}
+
+		return result * limb_jacobi(limbs_mod_1(n.data(), n.size(), x), x);
+	}
+
+	// Returns the floor of the square root of a normalized magnitude (Newton's method).
+	static limb_vector mag_sqrt(const limb_vector& a)
+	{
+		if (a.empty())
+		{
+			return {};
+		}
+
+		// Start at a power of two that's definitely above the root and work down
+		limb_vector x = { 1 };
+		mag_shift_left(x, (mag_bit_length(a) + 1) / 2);
+
+		while (true)
+		{
+			limb_vector y = mag_add(x, mag_divmod(a, x, nullptr));
+			mag_shift_right(y, 1);
+
+			if (mag_compare(y, x) >= 0)
+			{
+				return x;
+			}
+
+			x = std::move(y);
+		}
+	}
+
+	// Returns true if a is a perfect square. Most numbers get ruled out by a few residues before the square root is needed.
+	static bool mag_is_square(const limb_vector& a)
+	{
+		auto is_square_mod = [](limb_t residue, limb_t modulus)
+		{
+			for (limb_t i = 0; i < modulus; i++)
+			{
+				if (i * i % modulus == residue)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		if (a.empty())
+		{
+			return true;
+		}
+
+		// 63 * 65 * 11 is one pass over a for three more filters
+		const limb_t residue = limbs_mod_1(a.data(), a.size(), 63 * 65 * 11);
+
+		if (!is_square_mod(a[0] & 63, 64) || !is_square_mod(residue % 63, 63) || !is_square_mod(residue % 65, 65) || !is_square_mod(residue % 11, 11))
+		{
+			return false;
+		}
+
+		const limb_vector root = mag_sqrt(a);
+		return mag_mul(root, root) == a;
+	}
+
+	// Strong Lucas probable prime test with Selfridge's parameters, for an odd n that isn't a perfect square.
+	static bool mag_strong_lucas_probable_prime(const montgomery_context& context)
+	{
+		const limb_vector& n = context.modulus;
+
+		// The first D out of 5, -7, 9, -11, 13, ... where (D / n) = -1, then P = 1 and Q = (1 - D) / 4.
+		// This always ends quickly because n isn't a square.
+		int64_t d = 5;
+
+		while (true)
+		{
+			const int jacobi = mag_jacobi(n, d);
+
+			if (jacobi == -1)
+			{
+				break;
+			}
+			else if (jacobi == 0)
+			{
+				// n shares a factor with D, and n is way bigger than D.
+				return false;
+			}
+
+			d = (d > 0 ? -(d + 2) : -(d - 2));
+		}
+
+		auto to_form = [&context](int64_t value)
+		{
+			const limb_vector result = context.to_form({ value < 0 ? 0 - static_cast<limb_t>(value) : static_cast<limb_t>(value) });
+			return value < 0 ? context.sub(limb_vector(context.size()), result) : result;
+		};
+
+		const limb_vector form_d = to_form(d);
+		const limb_vector form_q = to_form((1 - d) / 4);
+
+		// n + 1 = k * 2^s
+		limb_vector k = mag_add(n, { 1 });
+		const size_t s = mag_countr_zero(k);
+		mag_shift_right(k, s);
+
+		// Walk U(k), V(k) and Q^k down the bits of k starting from U(1) = 1, V(1) = P = 1
+		limb_vector u = context.one;
+		limb_vector v = context.one;
+		limb_vector q_power = form_q;
+
+		for (size_t bit = mag_bit_length(k) - 1; bit != 0; bit--)
+		{
+			// U(2j) = U(j) * V(j), V(2j) = V(j)^2 - 2 * Q^j
+			u = context.mul(u, v);
+			v = context.sub(context.mul(v, v), context.add(q_power, q_power));
+			q_power = context.mul(q_power, q_power);
+
+			if ((k[(bit - 1) / limb_bits] >> ((bit - 1) % limb_bits)) & 1)
+			{
+				// U(j + 1) = (P * U(j) + V(j)) / 2, V(j + 1) = (D * U(j) + P * V(j)) / 2
+				limb_vector next_u = context.half(context.add(u, v));
+				v = context.half(context.add(context.mul(form_d, u), v));
+				u = std::move(next_u);
+				q_power = context.mul(q_power, form_q);
+			}
+		}
+
+		const limb_vector zero(context.size());
+
+		if (u == zero || v == zero)
+		{
+			return true;
+		}
+
+		for (size_t i = 1; i < s; i++)
+		{
+			// V(2j) = V(j)^2 - 2 * Q^j
+			v = context.sub(context.mul(v, v), context.add(q_power, q_power));
+
+			if (v == zero)
+			{
+				return true;
+			}
+
+			q_power = context.mul(q_power, q_power);
+		}
+
+		return false;
+	}
+
+	// BPSW for an odd n that's bigger than small_prime_limit and has no small factors.
+	static bool mag_bpsw(const limb_vector& n)
+	{
+		const montgomery_context context(n);
+		return mag_strong_probable_prime(context, { 2 }) && !mag_is_square(n) && mag_strong_lucas_probable_prime(context);
+	}
+};
+
+// Formats LargeInts like the built in integers: [[fill]align][sign][#][0][width][grouping][type]
+// Align is <, > or ^, sign is +, - or space, # adds a 0x, 0X, 0b, 0B or 0 prefix and a 0 pads with zeros after the sign and prefix.
+// Grouping is , or _ and puts that character between every 3 decimal digits or every 4 digits in other bases.
+// Type is d (the default), x, X, b, B or o. Nested width arguments aren't supported.
+template<>
+struct std::formatter<LargeInt>
+{
+	char fill = ' ';
+	char align = '\0';
+	char sign = '-';
+	bool alternate = false;
+	bool zero_pad = false;
+	size_t width = 0;
+	char grouping = '\0';
+	char type = 'd';
+
+	template<typename ParseContext>
+	constexpr auto parse(ParseContext& ctx)
+	{
+		auto iter = ctx.begin();
+		const auto end = ctx.end();
+
+		auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+
+		if (iter != end && std::next(iter) != end && *iter != '}' && is_align(*std::next(iter)))
+		{
+			fill = *iter++;
+			align = *iter++;
+		}
+		else if (iter != end && is_align(*iter))
+		{
+			align = *iter++;
+		}
+
+		if (iter != end && (*iter == '+' || *iter == '-' || *iter == ' '))
+		{
+			sign = *iter++;
+		}
+
+		if (iter != end && *iter == '#')
+		{
+			alternate = true;
+			iter++;
+		}
+
+		if (iter != end && *iter == '0')
+		{
+			zero_pad = true;
+			iter++;
+		}
+
+		while (iter != end && *iter >= '0' && *iter <= '9')
+		{
+			width = width * 10 + static_cast<size_t>(*iter++ - '0');
+		}
+
+		if (iter != end && (*iter == ',' || *iter == '_'))
+		{
+			grouping = *iter++;
+		}
+
+		if (iter != end && *iter != '}')
+		{
+			type = *iter++;
+
+			if (type != 'd' && type != 'x' && type != 'X' && type != 'b' && type != 'B' && type != 'o')
+			{
+				throw std::format_error("Invalid presentation type for LargeInt.");
+			}
+		}
+
+		if (iter != end && *iter != '}')
+		{
+			throw std::format_error("Invalid format specification for LargeInt.");
+		}
+
+		return iter;
+	}
+
+	template<typename FormatContext>
+	auto format(const LargeInt& num, FormatContext& ctx) const
+	{
+		return write(ctx.out(), num);
+	}
+
+	// Writes the number with the parsed options to any char output iterator.
+	// Power of two bases are pulled straight out of the limbs from the top, other bases have to be turned into digits first.
+	template<typename OutputIt>
+	OutputIt write(OutputIt out, const LargeInt& num) const
+	{
+		const LargeInt::limb_vector limbs = num.to_limbs();
+		const bool negative = num.is_negative();
+
+		LargeInt::limb_t base = 10;
+		std::string_view prefix;
+
+		switch (type)
+		{
+		case 'x': base = 16; prefix = "0x"; break;
+		case 'X': base = 16; prefix = "0X"; break;
+		case 'b': base = 2; prefix = "0b"; break;
+		case 'B': base = 2; prefix = "0B"; break;
+		case 'o': base = 8; prefix = (limbs.empty() ? "" : "0"); break;
+		default: break;
+		}
+
+		if (!alternate)
+		{
+			prefix = {};
+		}
+
+		const size_t bits_per_digit = (base == 10 ? 0 : static_cast<size_t>(std::countr_zero(base)));
+		std::string digits;
+		size_t digit_count = 1;
+
+		if (bits_per_digit == 0)
+		{
+			digits = LargeInt::mag_to_string(limbs, base, false);
+			digit_count = digits.size();
+		}
+		else if (!limbs.empty())
+		{
+			digit_count = (LargeInt::mag_bit_length(limbs) + bits_per_digit - 1) / bits_per_digit;
+		}
+
+		const size_t group_size = (base == 10 ? 3 : 4);
+		const size_t separators = (grouping != '\0' ? (digit_count - 1) / group_size : 0);
+		const char sign_char = (negative ? '-' : (sign == '-' ? '\0' : sign));
+		const size_t length = (sign_char != '\0' ? 1 : 0) + prefix.size() + digit_count + separators;
+		const size_t padding = (width > length ? width - length : 0);
+
+		// '=' only comes from std::internal on a stream: the fill goes between the sign or prefix and the digits, like a zero pad does.
+		// Except that the built in integers count octal's 0 as a digit, so it goes after the padding.
+		const bool zeros = (align == '=' || (zero_pad && align == '\0'));
+		const bool pad_before_prefix = (align == '=' && type == 'o');
+		const size_t before = (zeros ? 0 : (align == '<' ? 0 : (align == '^' ? padding / 2 : padding)));
+		const size_t after = (zeros ? 0 : padding - before);
+
+		out = std::fill_n(out, before, fill);
+
+		if (sign_char != '\0')
+		{
+			*out++ = sign_char;
+		}
+
+		if (pad_before_prefix)
+		{
+			out = std::fill_n(out, padding, fill);
+		}
+
+		out = std::copy(prefix.begin(), prefix.end(), out);
+
+		if (zeros && !pad_before_prefix)
+		{
+			out = std::fill_n(out, padding, (align == '=' ? fill : '0'));
+		}
+
+		const char* const digit_chars = (type == 'X' ? "0123456789ABCDEF" : "0123456789abcdef");
+
+		for (size_t i = digit_count; i > 0; i--)
+		{
+			char c;
+
+			if (bits_per_digit == 0)
+			{
+				c = digits[digit_count - i];
+			}
+			else
+			{
+				// Digit i - 1 from the bottom, which might straddle two limbs
+				const size_t position = (i - 1) * bits_per_digit;
+				const size_t shift = position % LargeInt::limb_bits;
+				const size_t index = position / LargeInt::limb_bits;
+				LargeInt::limb_t bits = (index < limbs.size() ? limbs[index] >> shift : 0);
+
+				if (shift + bits_per_digit > LargeInt::limb_bits && index + 1 < limbs.size())
+				{
+					bits |= limbs[index + 1] << (LargeInt::limb_bits - shift);
+				}
+
+				c = digit_chars[bits & (base - 1)];
+			}
+
+			*out++ = c;
+
+			if (separators != 0 && i != 1 && (i - 1) % group_size == 0)
+			{
+				*out++ = grouping;
+			}
+		}
+
+		return std::fill_n(out, after, fill);
+	}
+};
+
+// Writes the number with the stream's base, width, fill, adjustment, showbase, showpos and uppercase flags.
+std::ostream& operator<<(std::ostream& out, const LargeInt& num)
+{
+	const std::ostream::sentry sentry(out);
+
+	if (!sentry)
+	{
+		return out;
+	}
+
+	const std::ios_base::fmtflags flags = out.flags();
+	std::formatter<LargeInt> formatter;
+
+	switch (flags & std::ios_base::basefield)
+	{
+	case std::ios_base::hex: formatter.type = ((flags & std::ios_base::uppercase) ? 'X' : 'x'); break;
+	case std::ios_base::oct: formatter.type = 'o'; break;
+	default: break;
+	}
+
+	// Like the built in integers, zero never gets a base prefix and only decimal numbers get a plus.
+	formatter.alternate = ((flags & std::ios_base::showbase) != 0 && static_cast<bool>(num));
+	formatter.sign = ((flags & std::ios_base::showpos) && formatter.type == 'd' ? '+' : '-');
+	formatter.fill = out.fill();
+	formatter.width = static_cast<size_t>(std::max<std::streamsize>(out.width(), 0));
+
+	switch (flags & std::ios_base::adjustfield)
+	{
+	case std::ios_base::left: formatter.align = '<'; break;
+	case std::ios_base::internal: formatter.align = '='; break;
+	default: formatter.align = '>'; break;
+	}
+
+	const std::ostreambuf_iterator<char> end = formatter.write(std::ostreambuf_iterator<char>(out), num);
+	out.width(0);
+
+	if (end.failed())
+	{
+		out.setstate(std::ios_base::badbit);
+	}
+
+	return out;
+}
+
+// Reads a number the way the built in integers are read: whitespace is skipped (unless std::noskipws), then an optional sign, then digits in
+// the base the stream is set to. With no base set, a leading 0x means hexadecimal and a leading 0 octal. Hexadecimal can start with 0x either way.
+// The digits are converted a block at a time as they come in, so even numbers with millions of digits never need a string holding all of them.
+// Sets failbit and leaves num alone if there are no digits or the number doesn't fit in num's max size, and keeps num's max size otherwise.
+std::istream& operator>>(std::istream& in, LargeInt& num)
+{
+	const std::istream::sentry sentry(in);
+
+	if (!sentry)
+	{
+		return in;
+	}
+
+	std::streambuf* const buffer = in.rdbuf();
+	std::ios_base::iostate state = std::ios_base::goodbit;
+
+	LargeInt::limb_t base = 0;
+
+	switch (in.flags() & std::ios_base::basefield)
+	{
+	case std::ios_base::dec: base = 10; break;
+	case std::ios_base::hex: base = 16; break;
+	case std::ios_base::oct: base = 8; break;
+	default: break;
+	}
+
+	using traits = std::streambuf::traits_type;
+
+	// Characters are looked at before being taken, so whatever ends the number is left in the stream.
+	auto is_digit = [&](traits::int_type c)
+	{
+		return !traits::eq_int_type(c, traits::eof()) && LargeInt::digit_value(traits::to_char_type(c)) < base;
+	};
+
+	traits::int_type c = buffer->sgetc();
+	const bool negative = (c == '-');
+
+	if (c == '-' || c == '+')
+	{
+		c = buffer->snextc();
+	}
+
+	// A leading 0 is a digit on its own unless it turns out to be the start of 0x.
+	bool leading_zero = false;
+
+	if ((base == 0 || base == 16) && c == '0')
+	{
+		leading_zero = true;
+		c = buffer->snextc();
+
+		if (c == 'x' || c == 'X')
+		{
+			leading_zero = false;
+			base = 16;
+			c = buffer->snextc();
+		}
+		else if (base == 0)
+		{
+			base = 8;
+		}
+	}
+
+	if (base == 0)
+	{
+		base = 10;
+	}
+
+	LargeInt::digit_reader reader(base);
+	std::string block;
+	block.reserve(reader.block_size());
+	bool any_digits = leading_zero;
+
+	while (is_digit(c))
+	{
+		block.push_back(traits::to_char_type(c));
+		any_digits = true;
+
+		if (block.size() == reader.block_size())
+		{
+			reader.push(block);
+			block.clear();
+		}
+
+		c = buffer->snextc();
+	}
+
+	if (!block.empty())
+	{
+		reader.push(block);
+	}
+
+	if (traits::eq_int_type(c, traits::eof()))
+	{
+		state |= std::ios_base::eofbit;
+	}
+
+	if (!any_digits)
+	{
+		in.setstate(state | std::ios_base::failbit);
+		return in;
+	}
+
+	LargeInt result = LargeInt::from_limbs(reader.finish(), negative, 0);
+
+	if (num.max_size != 0 && result.size > num.max_size)
+	{
+		in.setstate(state | std::ios_base::failbit);
+		return in;
+	}
+
+	result.max_size = num.max_size;
+	num = std::move(result);
+	in.setstate(state);
+
+	return in;
+}
+
+// Shifting or inverting a view needs somewhere to put the result, so these copy it into a LargeInt first.
+template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+inline LargeInt operator<<(const LargeIntView& view, Integer other)
+{
+	LargeInt new_val(view);
+	new_val <<= other;
+
+	return new_val;
+}
+
+template<typename Integer, std::enable_if_t<std::is_integral<Integer>::value, bool> = true>
+inline LargeInt operator>>(const LargeIntView& view, Integer other)
+{
+	LargeInt new_val(view);
+	new_val >>= other;
+
+	return new_val;
+}
+
+inline LargeInt operator~(const LargeIntView& view)
+{
+	return ~LargeInt(view);
+}
+
+// A number that's worked out at compile time, as its magnitude in a fixed number of 64-bit limbs (least significant first) plus a sign.
+// A LargeInt keeps its bytes on the heap, and heap memory can't outlive constant evaluation, so a constexpr LargeInt can't exist.
+// These can: everything here is constexpr (the limb math is the same code LargeInt uses), a constexpr one ends up in read only data,
+// and it converts to a LargeIntView for free or to a LargeInt with LargeInt(constant). Make them with the _li literal below.
+// Adding and subtracting give one more limb than the bigger side, and multiplying gives the sum of both sides' limbs, so nothing overflows.
+template<size_t Limbs>
+class LargeIntConstant
+{
+public:
+	// A constant of 0.
+	constexpr LargeIntConstant() noexcept = default;
+
+	// -0 is just 0.
+	constexpr LargeIntConstant(const std::array<uint64_t, Limbs>& limbs, bool negative = false) noexcept : limbs(limbs)
+	{
+		this->negative = negative && bit_length() > 0;
+	}
+
+	// Changes the number of limbs. Limbs that don't fit are dropped.
+	template<size_t Other>
+	constexpr explicit LargeIntConstant(const LargeIntConstant<Other>& other) noexcept
+	{
+		std::copy_n(other.limbs.begin(), std::min(Limbs, Other), limbs.begin());
+		negative = other.negative && bit_length() > 0;
+	}
+
+	// Parses the characters of an integer literal. Hex (0x), binary (0b), octal (a leading 0) and decimal all work, and so do ' separators.
+	// Anything that doesn't fit in the limbs is dropped.
+	template<char... Chars>
+	static consteval LargeIntConstant from_literal() noexcept
+	{
+		const char chars[] = { Chars... };
+		std::string_view digits(chars, sizeof...(Chars));
+		uint64_t base = 10;
+
+		if (digits.size() > 1 && digits[0] == '0')
+		{
+			if (digits[1] == 'x' || digits[1] == 'X')
+			{
+				base = 16;
+				digits.remove_prefix(2);
+			}
+			else if (digits[1] == 'b' || digits[1] == 'B')
+			{
+				base = 2;
+				digits.remove_prefix(2);
+			}
+			else
+			{
+				base = 8;
+				digits.remove_prefix(1);
+			}
+		}
+
+		LargeIntConstant result;
+
+		for (const char c : digits)
+		{
+			if (c == '\'')
+			{
+				continue;
+			}
+
+			const uint64_t digit = static_cast<uint64_t>(c >= 'a' ? c - 'a' + 10 : (c >= 'A' ? c - 'A' + 10 : c - '0'));
+			LargeInt::limbs_mul_1(result.limbs.data(), result.limbs.data(), Limbs, base);
+			LargeInt::limbs_add_1(result.limbs.data(), result.limbs.data(), Limbs, digit);
+		}
+
+		return result;
+	}
+
+	constexpr const std::array<uint64_t, Limbs>& get_limbs() const noexcept
+	{
+		return limbs;
+	}
+
+	constexpr bool is_negative() const noexcept
+	{
+		return negative;
+	}
+
+	// Get the number of bits in the magnitude, like LargeIntView::bit_length().
+	constexpr size_t bit_length() const noexcept
+	{
+		for (size_t i = Limbs; i > 0; i--)
+		{
+			if (limbs[i - 1] != 0)
+			{
+				return i * 64 - std::countl_zero(limbs[i - 1]);
+			}
+		}
+
+		return 0;
+	}
+
+	// Views the limbs in place, so a constant works anywhere a view does.
+	constexpr operator LargeIntView() const noexcept
+	{
+		return LargeIntView(limbs, negative);
+	}
+
+	constexpr LargeIntConstant operator-() const noexcept
+	{
+		return LargeIntConstant(limbs, !negative);
+	}
+
+	template<size_t Other>
+	constexpr LargeIntConstant<std::max(Limbs, Other) + 1> operator+(const LargeIntConstant<Other>& other) const noexcept
+	{
+		constexpr size_t n = std::max(Limbs, Other) + 1;
+		std::array<uint64_t, n> a = {};
+		std::array<uint64_t, n> b = {};
+		std::copy(limbs.begin(), limbs.end(), a.begin());
+		std::copy(other.limbs.begin(), other.limbs.end(), b.begin());
+
+		if (negative == other.negative)
+		{
+			LargeInt::limbs_add_n(a.data(), a.data(), b.data(), n);
+			return LargeIntConstant<n>(a, negative);
+		}
+
+		// The signs are different, so it's the bigger magnitude minus the smaller one, with the bigger one's sign.
+		if (LargeInt::limbs_compare(a.data(), b.data(), n) >= 0)
+		{
+			LargeInt::limbs_sub_n(a.data(), a.data(), b.data(), n);
+			return LargeIntConstant<n>(a, negative);
+		}
+
+		LargeInt::limbs_sub_n(b.data(), b.data(), a.data(), n);
+		return LargeIntConstant<n>(b, other.negative);
+	}
+
+	template<size_t Other>
+	constexpr LargeIntConstant<std::max(Limbs, Other) + 1> operator-(const LargeIntConstant<Other>& other) const noexcept
+	{
+		return *this + -other;
+	}
+
+	template<size_t Other>
+	constexpr LargeIntConstant<Limbs + Other> operator*(const LargeIntConstant<Other>& other) const noexcept
+	{
+		std::array<uint64_t, Limbs + Other> product = {};
+
+		for (size_t i = 0; i < Other; i++)
+		{
+			product[i + Limbs] = LargeInt::limbs_addmul_1(product.data() + i, limbs.data(), Limbs, other.limbs[i]);
+		}
+
+		return LargeIntConstant<Limbs + Other>(product, negative != other.negative);
+	}
+
+	template<size_t Other>
+	constexpr std::weak_ordering operator<=>(const LargeIntConstant<Other>& other) const noexcept
+	{
+		return LargeIntView(*this) <=> LargeIntView(other);
+	}
+
+	template<size_t Other>
+	constexpr bool operator==(const LargeIntConstant<Other>& other) const noexcept
+	{
+		return LargeIntView(*this) == LargeIntView(other);
+	}
+
+private:
+	std::array<uint64_t, Limbs> limbs = {};
+	bool negative = false;
+
+	template<size_t>
+	friend class LargeIntConstant;
+};
+
+// 123_li, 0xdead'beef_li and so on make a LargeIntConstant at compile time, with just enough limbs to hold the number.
+// Negative numbers are the unary minus of one, e.g. -5_li. A LargeInt can be made from one with LargeInt(123_li).
+template<char... Chars>
+consteval auto operator""_li() noexcept
+{
+	// No base up to 16 takes more than 4 bits a digit, so parse into that many limbs and then drop the ones on top that weren't needed.
+	constexpr auto parsed = LargeIntConstant<(sizeof...(Chars) * 4 + 63) / 64>::template from_literal<Chars...>();
+	return LargeIntConstant<(parsed.bit_length() + 63) / 64>(parsed);
+}
+
+// Expression templates, for when a whole expression should be worked out in one go instead of a LargeInt at a time.
+// LargeInt::lazy(a) * b + c - d only builds a tree pointing at a, b, c and d. Turning the tree into a LargeInt then evaluates it on limbs
+// with a single conversion at the end: the terms are summed in place in one buffer that's sized for the result up front, and products
+// that are being added or subtracted are added to that buffer as limbs (see LargeInt::signed_addmul()) instead of becoming LargeInts of their own.
+// A product with a single limb factor is multiplied straight into the buffer, anything bigger still needs one scratch product.
+// Like with the normal operators, every +, - and * wraps around to the max size of its leftmost number, so the result is the same
+// as writing the expression without lazy(). Since the tree only points at its numbers, it shouldn't be kept around
+// (in an auto variable, say) past the end of the statement that made it.
+
+// A number at the bottom of an expression tree.
+class LargeIntLeaf
+{
+public:
+	explicit LargeIntLeaf(const LargeInt& num) noexcept : num(&num)
+	{}
+
+	operator LargeInt() const
+	{
+		return *num;
+	}
+
+	// Upper bound on the limbs the value takes.
+	size_t limb_bound() const noexcept
+	{
+		return (num->value.size() + LargeInt::limb_bytes - 1) / LargeInt::limb_bytes;
+	}
+
+	size_t max_size() const noexcept
+	{
+		return num->max_size;
+	}
+
+	// out += num (or -= if negative). The number already fits in its max size, so there's nothing to wrap around.
+	void accumulate(LargeInt::signed_limbs& out, bool negative, size_t) const
+	{
+		// The first term goes straight into the buffer without a copy in between.
+		if (out.magnitude.empty())
+		{
+			out.magnitude.resize(limb_bound());
+			out.magnitude.resize(num->copy_limbs(out.magnitude.data()));
+			out.negative = (num->is_negative() != negative) && !out.magnitude.empty();
+			return;
+		}
+
+		const LargeInt::limb_vector limbs = num->to_limbs();
+		LargeInt::signed_add(out, limbs.data(), limbs.size(), num->is_negative() != negative);
+	}
+
+private:
+	const LargeInt* num;
+};
+
+// Two subtrees joined by +, - or *.
+template<typename Left, typename Right, char op>
+class LargeIntExpr
+{
+public:
+	LargeIntExpr(const Left& left, const Right& right) noexcept : left(left), right(right)
+	{}
+
+	// Evaluates the whole tree. The wrap around of the top operator is left to from_limbs().
+	operator LargeInt() const
+	{
+		LargeInt::signed_limbs result;
+		result.magnitude.reserve(limb_bound() + 1);
+		accumulate(result, false, max_size());
+
+		return LargeInt::from_limbs(result.magnitude, result.negative, max_size());
+	}
+
+	// Upper bound on the limbs the value takes.
+	size_t limb_bound() const noexcept
+	{
+		return (op == '*' ? left.limb_bound() + right.limb_bound() : std::max(left.limb_bound(), right.limb_bound()) + 1);
+	}
+
+	size_t max_size() const noexcept
+	{
+		return left.max_size();
+	}
+
+	// out += this (or -= if negative), where whatever out ends up as gets wrapped around to limit bytes later on (0 if it doesn't).
+	// Wrapping around is just working modulo a power of 2, so it can wait until the end and happen once, unless this operator's
+	// own max size is smaller than the limit. Then this subtree gets worked out on its own and wrapped around first.
+	void accumulate(LargeInt::signed_limbs& out, bool negative, size_t limit) const
+	{
+		const size_t bytes = max_size();
+
+		if (bytes != 0 && (limit == 0 || bytes < limit))
+		{
+			LargeInt::signed_limbs own;
+			accumulate(own, false, bytes);
+			LargeInt::signed_truncate(own, bytes);
+			LargeInt::signed_add(out, own.magnitude.data(), own.magnitude.size(), own.negative != negative);
+			return;
+		}
+
+		if constexpr (op == '*')
+		{
+			LargeInt::signed_limbs a;
+			LargeInt::signed_limbs b;
+			left.accumulate(a, false, limit);
+			right.accumulate(b, false, limit);
+
+			LargeInt::signed_addmul(out, a.magnitude, b.magnitude, negative != (a.negative != b.negative));
+		}
+		else
+		{
+			left.accumulate(out, negative, limit);
+			right.accumulate(out, negative != (op == '-'), limit);
+		}
+	}
+
+private:
+	Left left;
+	Right right;
+};
+
+template<typename T>
+struct is_large_int_expr : std::false_type
+{};
+
+template<>
+struct is_large_int_expr<LargeIntLeaf> : std::true_type
+{};
+
+template<typename Left, typename Right, char op>
+struct is_large_int_expr<LargeIntExpr<Left, Right, op>> : std::true_type
+{};
+
+inline LargeIntLeaf LargeInt::lazy(const LargeInt& num) noexcept
+{
+	return LargeIntLeaf(num);
+}
+
+// LargeInts used in an expression become leaves, anything that's already part of one stays as it is.
+inline LargeIntLeaf large_int_expr_node(const LargeInt& num) noexcept
+{
+	return LargeIntLeaf(num);
+}
+
+template<typename Expr, std::enable_if_t<is_large_int_expr<Expr>::value, bool> = true>
+inline const Expr& large_int_expr_node(const Expr& expr) noexcept
+{
+	return expr;
+}
+
+// The operators only kick in if at least one side is already an expression, so plain LargeInt arithmetic is left alone.
+template<typename Left, typename Right>
+using large_int_expr_operands = std::enable_if_t<(is_large_int_expr<Left>::value || is_large_int_expr<Right>::value)
+	&& (is_large_int_expr<Left>::value || std::is_same<Left, LargeInt>::value) && (is_large_int_expr<Right>::value || std::is_same<Right, LargeInt>::value), bool>;
+
+template<typename Left, typename Right, char op>
+using large_int_expr_type = LargeIntExpr<std::decay_t<decltype(large_int_expr_node(std::declval<const Left&>()))>, std::decay_t<decltype(large_int_expr_node(std::declval<const Right&>()))>, op>;
+
+template<typename Left, typename Right, large_int_expr_operands<Left, Right> = true>
+inline large_int_expr_type<Left, Right, '+'> operator+(const Left& left, const Right& right) noexcept
+{
+	return large_int_expr_type<Left, Right, '+'>(large_int_expr_node(left), large_int_expr_node(right));
+}
+
+template<typename Left, typename Right, large_int_expr_operands<Left, Right> = true>
+inline large_int_expr_type<Left, Right, '-'> operator-(const Left& left, const Right& right) noexcept
+{
+	return large_int_expr_type<Left, Right, '-'>(large_int_expr_node(left), large_int_expr_node(right));
+}
+
+template<typename Left, typename Right, large_int_expr_operands<Left, Right> = true>
+inline large_int_expr_type<Left, Right, '*'> operator*(const Left& left, const Right& right) noexcept
+{
+	return large_int_expr_type<Left, Right, '*'>(large_int_expr_node(left), large_int_expr_node(right));
+}
+
+// An integer modulo some odd number, for when a lot of arithmetic happens under the same modulus.
+// The value is kept in Montgomery form, so multiplication never needs a division, and only gets turned back into a LargeInt when asked for.
+// The modulus is shared between every ModInt made with it, create one with ModInt::make_modulus().
+// Mixing ModInts with different moduli throws modulus_mismatch.
+class ModInt
+{
+public:
+	// Throwable class for when a ModInt modulus isn't a positive odd number
+	class invalid_modulus : public std::logic_error
+	{
+	public:
+		invalid_modulus(const std::string& what_arg) : logic_error(what_arg)
+		{}
+
+		invalid_modulus(const char* what_arg) : logic_error(what_arg)
+		{}
+
+		invalid_modulus(const invalid_modulus& other) = default;
+	};
+
+	// Throwable class for when two ModInts with different moduli meet
+	class modulus_mismatch : public std::logic_error
+	{
+	public:
+		modulus_mismatch(const std::string& what_arg) : logic_error(what_arg)
+		{}
+
+		modulus_mismatch(const char* what_arg) : logic_error(what_arg)
+		{}
+
+		modulus_mismatch(const modulus_mismatch& other) = default;
+	};
+
+	// The part that's shared: the modulus and everything precomputed for it.
+	class modulus
+	{
+	public:
+		// Throws invalid_modulus if the value isn't a positive odd number.
+		explicit modulus(const LargeInt& value) : value(value, 0), context(checked_limbs(value))
+		{}
+
+		const LargeInt& get_value() const noexcept
+		{
+			return value;
+		}
+
+	private:
+		friend class ModInt;
+
+		LargeInt value;
+		LargeInt::montgomery_context context;
+
+		static LargeInt::limb_vector checked_limbs(const LargeInt& value)
+		{
+			LargeInt::limb_vector limbs = value.to_limbs();
+
+			if (value.is_negative() || limbs.empty() || (limbs[0] & 1) == 0)
+			{
+				throw invalid_modulus("ModInt modulus that isn't a positive odd number.");
+			}
+
+			return limbs;
+		}
+	};
+
+	// Precomputes a modulus to be shared by any number of ModInts.
+	// Throws invalid_modulus if the value isn't a positive odd number.
+	static std::shared_ptr<const modulus> make_modulus(const LargeInt& value)
+	{
+		return std::make_shared<const modulus>(value);
+	}
+
+	// Reduces the value (negative or not) into the modulus.
+	ModInt(const LargeInt& value, std::shared_ptr<const modulus> mod) : mod(std::move(mod))
+	{
+		const LargeInt::montgomery_context& context = this->mod->context;
+		form = context.to_form(value.to_limbs());
+
+		if (value.is_negative())
+		{
+			form = context.sub(LargeInt::limb_vector(context.size()), form);
+		}
+	}
+
+	ModInt operator+() const
+	{
+		return *this;
+	}
+
+	ModInt operator-() const
+	{
+		return ModInt(context().sub(LargeInt::limb_vector(context().size()), form), mod);
+	}
+
+	ModInt operator+(const ModInt& other) const
+	{
+		check_modulus(other);
+		return ModInt(context().add(form, other.form), mod);
+	}
+
+	ModInt& operator+=(const ModInt& other)
+	{
+		*this = *this + other;
+		return *this;
+	}
+
+	ModInt operator-(const ModInt& other) const
+	{
+		check_modulus(other);
+		return ModInt(context().sub(form, other.form), mod);
+	}
+
+	ModInt& operator-=(const ModInt& other)
+	{
+		*this = *this - other;
+		return *this;
+	}
+
+	ModInt operator*(const ModInt& other) const
+	{
+		check_modulus(other);
+		return ModInt(context().mul(form, other.form), mod);
+	}
+
+	ModInt& operator*=(const ModInt& other)
+	{
+		*this = *this * other;
+		return *this;
+	}
+
+	// Raises the number to the given power. A negative exponent raises the inverse instead.
+	// Throws LargeInt::not_invertible if the exponent is negative and there's no inverse.
+	ModInt pow(const LargeInt& exponent) const
+	{
+		const ModInt base = (exponent.is_negative() ? inverse() : *this);
+		return ModInt(context().pow(base.form, exponent.to_limbs()), mod);
+	}
+
+	// Returns the multiplicative inverse.
+	// Throws LargeInt::not_invertible if the value and the modulus aren't coprime.
+	ModInt inverse() const
+	{
+		return ModInt(LargeInt::invert(get_value(), mod->value), mod);
+	}
+
+	bool operator==(const ModInt& other) const
+	{
+		check_modulus(other);
+		return form == other.form;
+	}
+
+	// Returns the value as a LargeInt in [0, modulus).
+	LargeInt get_value() const
+	{
+		return LargeInt::from_limbs(context().from_form(form), false, 0);
+	}
+
+	const std::shared_ptr<const modulus>& get_modulus() const noexcept
+	{
+		return mod;
+	}
+
+	explicit operator LargeInt() const
+	{
+		return get_value();
+	}
+
+private:
+	std::shared_ptr<const modulus> mod;
+	LargeInt::limb_vector form;
+
+	ModInt(LargeInt::limb_vector form, std::shared_ptr<const modulus> mod) : mod(std::move(mod)), form(std::move(form))
+	{}
+
+	const LargeInt::montgomery_context& context() const noexcept
+	{
+		return mod->context;
+	}
+
+	void check_modulus(const ModInt& other) const
+	{
+		if (mod != other.mod && mod->value != other.mod->value)
+		{
+			throw modulus_mismatch("ModInt arithmetic with two different moduli.");
+		}
+	}
+};
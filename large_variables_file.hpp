@@ -0,0 +1,430 @@
+#pragma once
+
+#include "large_variables.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined (_WIN32)
+#if !defined (NOMINMAX)
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Bulk file format for lots of (possibly huge) LargeInts, meant to be memory mapped instead of parsed.
+// Everything is little endian:
+// - A 64 byte header: the magic "LVINTS\r\n", then the version, value count, index offset and payload alignment as 64 bit numbers. The rest is 0.
+// - The payloads, each one the magnitude of a value as 64 bit limbs, starting at a multiple of the payload alignment.
+// - The index at the end, 16 bytes per value: the offset of its payload, then (limb count << 1) | sign.
+// The index goes last so the writer can stream values out without knowing how many there'll be.
+namespace large_variables_file
+{
+	constexpr char magic[8] = { 'L', 'V', 'I', 'N', 'T', 'S', '\r', '\n' };
+	constexpr uint64_t version = 1;
+	constexpr uint64_t header_size = 64;
+	constexpr uint64_t payload_alignment = 64;
+	constexpr uint64_t index_entry_size = 16;
+
+	inline uint64_t load_u64(const uint8_t* bytes) noexcept
+	{
+		uint64_t num = 0;
+
+		for (size_t i = 0; i < sizeof(uint64_t); i++)
+		{
+			num |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+		}
+
+		return num;
+	}
+
+	inline void store_u64(uint8_t* bytes, uint64_t num) noexcept
+	{
+		for (size_t i = 0; i < sizeof(uint64_t); i++)
+		{
+			bytes[i] = static_cast<uint8_t>(num >> (8 * i));
+		}
+	}
+}
+
+// Throwable class for when a file isn't a valid LargeInt bulk file (i.e wrong magic, unknown version or offsets pointing outside the file)
+class invalid_large_int_file : public std::logic_error
+{
+public:
+	invalid_large_int_file(const std::string& what_arg) : logic_error(what_arg)
+	{}
+
+	invalid_large_int_file(const char* what_arg) : logic_error(what_arg)
+	{}
+
+	invalid_large_int_file(const invalid_large_int_file& other) = default;
+};
+
+// Writes a bulk file one value at a time. Only the index (16 bytes per value) is kept in memory until finish().
+// Throws std::system_error if the file can't be opened or written to.
+class LargeIntFileWriter
+{
+public:
+	explicit LargeIntFileWriter(const std::string& path) : file(path, std::ios::binary | std::ios::trunc)
+	{
+		if (!file)
+		{
+			throw std::system_error(std::make_error_code(std::errc::io_error), "Couldn't open " + path + " for writing.");
+		}
+
+		// The header gets filled in at the end, once the index offset is known.
+		pad_to(large_variables_file::header_size);
+	}
+
+	LargeIntFileWriter(const LargeIntFileWriter& other) = delete;
+	LargeIntFileWriter& operator=(const LargeIntFileWriter& other) = delete;
+
+	~LargeIntFileWriter()
+	{
+		if (!finished)
+		{
+			try
+			{
+				finish();
+			}
+			catch (...)
+			{}
+		}
+	}
+
+	// Appends a value. Its magnitude goes straight from its storage to the file.
+	void write(const LargeInt& num)
+	{
+		const size_t limbs = (num.magnitude_bit_length() + LargeInt::limb_bits - 1) / LargeInt::limb_bits;
+
+		pad_to((position + large_variables_file::payload_alignment - 1) / large_variables_file::payload_alignment * large_variables_file::payload_alignment);
+
+		index.push_back(position);
+		index.push_back((static_cast<uint64_t>(limbs) << 1) | (num.is_negative() ? 1 : 0));
+
+		const size_t bytes = limbs * LargeInt::limb_bytes;
+
+		// Positive numbers are already their own magnitude in storage, negative ones get negated on the way through.
+		if (!num.is_negative())
+		{
+			const size_t stored = std::min(bytes, num.value.size());
+			file.write(reinterpret_cast<const char*>(num.value.data()), static_cast<std::streamsize>(stored));
+			position += stored;
+			pad_to(position + (bytes - stored));
+		}
+		else
+		{
+			num.write_magnitude_bytes(std::ostreambuf_iterator<char>(file), bytes);
+			position += bytes;
+		}
+
+		check();
+	}
+
+	// Writes the index and the header. Nothing can be written after this. The destructor calls it if it hasn't been.
+	void finish()
+	{
+		if (finished)
+		{
+			return;
+		}
+
+		finished = true;
+
+		const uint64_t index_offset = position;
+		std::vector<uint8_t> bytes(index.size() * sizeof(uint64_t));
+
+		for (size_t i = 0; i < index.size(); i++)
+		{
+			large_variables_file::store_u64(bytes.data() + i * sizeof(uint64_t), index[i]);
+		}
+
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+		uint8_t header[large_variables_file::header_size] = {};
+		std::memcpy(header, large_variables_file::magic, sizeof(large_variables_file::magic));
+		large_variables_file::store_u64(header + 8, large_variables_file::version);
+		large_variables_file::store_u64(header + 16, index.size() / 2);
+		large_variables_file::store_u64(header + 24, index_offset);
+		large_variables_file::store_u64(header + 32, large_variables_file::payload_alignment);
+
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		file.flush();
+
+		check();
+		file.close();
+	}
+
+private:
+	std::ofstream file;
+	std::vector<uint64_t> index;
+	uint64_t position = 0;
+	bool finished = false;
+
+	void pad_to(uint64_t offset)
+	{
+		for (; position < offset; position++)
+		{
+			file.put(0);
+		}
+	}
+
+	void check()
+	{
+		if (!file)
+		{
+			throw std::system_error(std::make_error_code(std::errc::io_error), "Couldn't write to LargeInt file.");
+		}
+	}
+};
+
+// Memory maps a bulk file and hands out its values, either as LargeInts or as read only views of the mapped limbs.
+// The whole index is checked when the file is opened, so getting values afterwards can't go outside the file.
+// Throws std::system_error if the file can't be opened or mapped and invalid_large_int_file if it isn't a valid bulk file.
+class LargeIntFileReader
+{
+public:
+	// Values viewed straight out of the mapping. Only valid for as long as the reader is.
+	using view_type = LargeIntView;
+
+	explicit LargeIntFileReader(const std::string& path)
+	{
+		map(path);
+
+		try
+		{
+			validate();
+		}
+		catch (...)
+		{
+			unmap();
+			throw;
+		}
+	}
+
+	LargeIntFileReader(LargeIntFileReader&& other) noexcept :
+		data(std::exchange(other.data, nullptr)), length(std::exchange(other.length, 0)), count(std::exchange(other.count, 0)), index(std::exchange(other.index, nullptr))
+	{}
+
+	LargeIntFileReader& operator=(LargeIntFileReader&& other) noexcept
+	{
+		if (this != &other)
+		{
+			unmap();
+			data = std::exchange(other.data, nullptr);
+			length = std::exchange(other.length, 0);
+			count = std::exchange(other.count, 0);
+			index = std::exchange(other.index, nullptr);
+		}
+
+		return *this;
+	}
+
+	LargeIntFileReader(const LargeIntFileReader& other) = delete;
+	LargeIntFileReader& operator=(const LargeIntFileReader& other) = delete;
+
+	~LargeIntFileReader()
+	{
+		unmap();
+	}
+
+	// Number of values in the file.
+	size_t size() const noexcept
+	{
+		return count;
+	}
+
+	// Copies value i out of the file. Doesn't check i.
+	LargeInt get(size_t i) const
+	{
+		const auto [payload, limbs, negative] = entry(i);
+		return LargeInt::from_magnitude_bytes(data + payload, limbs * LargeInt::limb_bytes, negative);
+	}
+
+	// Views value i in place without copying anything. Doesn't check i.
+	// The payloads are little endian, so views are only handed out on little endian machines (std::logic_error otherwise, use get()).
+	view_type view(size_t i) const
+	{
+		if constexpr (std::endian::native != std::endian::little)
+		{
+			throw std::logic_error("LargeInt file views need a little endian machine.");
+		}
+
+		const auto [payload, limbs, negative] = entry(i);
+		return LargeIntView(std::span<const uint64_t>(reinterpret_cast<const uint64_t*>(data + payload), limbs), negative);
+	}
+
+private:
+	const uint8_t* data = nullptr;
+	size_t length = 0;
+	size_t count = 0;
+	const uint8_t* index = nullptr;
+
+	struct entry_type
+	{
+		size_t payload;
+		size_t limbs;
+		bool negative;
+	};
+
+	entry_type entry(size_t i) const noexcept
+	{
+		const uint64_t shape = large_variables_file::load_u64(index + i * large_variables_file::index_entry_size + 8);
+		return entry_type{ static_cast<size_t>(large_variables_file::load_u64(index + i * large_variables_file::index_entry_size)), static_cast<size_t>(shape >> 1), (shape & 1) != 0 };
+	}
+
+	void validate()
+	{
+		using namespace large_variables_file;
+
+		if (length < header_size || std::memcmp(data, magic, sizeof(magic)) != 0)
+		{
+			throw invalid_large_int_file("Not a LargeInt file.");
+		}
+
+		if (load_u64(data + 8) != version)
+		{
+			throw invalid_large_int_file("Unsupported LargeInt file version.");
+		}
+
+		const uint64_t entries = load_u64(data + 16);
+		const uint64_t index_offset = load_u64(data + 24);
+
+		if (index_offset < header_size || index_offset > length || entries > (length - index_offset) / index_entry_size)
+		{
+			throw invalid_large_int_file("LargeInt file index doesn't fit in the file.");
+		}
+
+		count = static_cast<size_t>(entries);
+		index = data + index_offset;
+
+		// Every payload has to be limb aligned and sit between the header and the index.
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint64_t payload = load_u64(index + i * index_entry_size);
+			const uint64_t limbs = load_u64(index + i * index_entry_size + 8) >> 1;
+
+			if (payload < header_size || payload % sizeof(uint64_t) != 0 || payload > index_offset || limbs > (index_offset - payload) / sizeof(uint64_t))
+			{
+				throw invalid_large_int_file("LargeInt file payload doesn't fit in the file.");
+			}
+		}
+	}
+
+	void map(const std::string& path)
+	{
+		#if defined (_WIN32)
+		const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Couldn't open " + path + ".");
+		}
+
+		LARGE_INTEGER file_size;
+
+		if (!GetFileSizeEx(file, &file_size))
+		{
+			const DWORD error = GetLastError();
+			CloseHandle(file);
+			throw std::system_error(static_cast<int>(error), std::system_category(), "Couldn't get the size of " + path + ".");
+		}
+
+		length = static_cast<size_t>(file_size.QuadPart);
+
+		if (length == 0)
+		{
+			CloseHandle(file);
+			return;
+		}
+
+		// The view keeps the mapping alive, so both handles can go right away.
+		const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		const DWORD error = GetLastError();
+		CloseHandle(file);
+
+		if (mapping == nullptr)
+		{
+			throw std::system_error(static_cast<int>(error), std::system_category(), "Couldn't map " + path + ".");
+		}
+
+		data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		const DWORD view_error = GetLastError();
+		CloseHandle(mapping);
+
+		if (data == nullptr)
+		{
+			throw std::system_error(static_cast<int>(view_error), std::system_category(), "Couldn't map " + path + ".");
+		}
+		#else
+		const int file = open(path.c_str(), O_RDONLY);
+
+		if (file < 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "Couldn't open " + path + ".");
+		}
+
+		struct stat file_stat;
+
+		if (fstat(file, &file_stat) != 0)
+		{
+			const int error = errno;
+			close(file);
+			throw std::system_error(error, std::generic_category(), "Couldn't get the size of " + path + ".");
+		}
+
+		length = static_cast<size_t>(file_stat.st_size);
+
+		if (length == 0)
+		{
+			close(file);
+			return;
+		}
+
+		// The mapping stays valid after the file is closed.
+		void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+		const int error = errno;
+		close(file);
+
+		if (mapping == MAP_FAILED)
+		{
+			throw std::system_error(error, std::generic_category(), "Couldn't map " + path + ".");
+		}
+
+		data = static_cast<const uint8_t*>(mapping);
+		#endif
+	}
+
+	void unmap() noexcept
+	{
+		if (data != nullptr)
+		{
+			#if defined (_WIN32)
+			UnmapViewOfFile(data);
+			#else
+			munmap(const_cast<uint8_t*>(data), length);
+			#endif
+		}
+
+		data = nullptr;
+		length = 0;
+		count = 0;
+		index = nullptr;
+	}
+};
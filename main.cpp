@@ -1,6 +1,7 @@
 // LargeVars.cpp : This file contains the 'main' function. Program execution begins and ends there.
 //
 
+#include "benchmark.hpp"
 #include "large_variables.hpp"
 #include "self_test.hpp"
 
@@ -27,6 +28,40 @@ int main(int argc, const char* const argv[])
 		self_test_bitwise();			// 11x
 		self_test_bitshift();			// 9x
 		self_test_unary();				// 11x
+		self_test_gcd();				// 114x
+		self_test_bits();				// 15x
+		self_test_combinatorics();		// <1x
+		self_test_primes();				// <1x
+		self_test_random();				// 3x
+		self_test_modint();				// <1x
+		self_test_parse();				// 33x
+		self_test_to_string();			// 11x
+		self_test_format();				// 8x
+		self_test_chars();				// 55x
+		self_test_serialize();			// 4x
+		self_test_file();				// <1x
+		self_test_float();				// 4x
+		self_test_import();				// 3x
+		self_test_view();				// 3x
+		self_test_stream();				// 7x
+		self_test_expr();				// <1x
+		self_test_rvalue();				// <1x
+		self_test_constant();			// <1x
+		self_test_addmul();				// <1x
+		self_test_reduce();				// <1x
+		self_test_parallel();			// <1x
+
+		return 0;
+	}
+
+	if (argc > 1 && strncmp(argv[1], "--bench", sizeof("--bench")) == 0)
+	{
+		benchmark_factorial();
+		benchmark_binomial();
+		benchmark_fibonacci();
+		benchmark_modint();
+		benchmark_parse();
+		benchmark_parallel_mul();
 
 		return 0;
 	}
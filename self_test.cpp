@@ -1,11 +1,27 @@
 #include "large_variables.hpp"
+#include "large_variables_file.hpp"
 #include "self_test.hpp"
 
+#include <atomic>
+#include <bit>
+#include <charconv>
 #include <chrono>
 #include <cstdint>
+#include <cstdlib>
+#include <filesystem>
 #include <format>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -102,6 +118,60 @@ static void set_process_affinity()
 }
 #endif
 
+// Counts the allocations made on each thread, for the tests that check something doesn't allocate.
+static thread_local size_t thread_allocations = 0;
+
+// While set, every allocation on a thread other than the one that set it throws std::bad_alloc,
+// for the tests that check what happens when threads the library starts run out of memory.
+static std::atomic<bool> fail_other_threads_allocations = false;
+static thread_local bool thread_may_allocate = false;
+
+void* operator new(std::size_t count)
+{
+	thread_allocations++;
+
+	if (fail_other_threads_allocations.load(std::memory_order_relaxed) && !thread_may_allocate)
+	{
+		throw std::bad_alloc();
+	}
+
+	if (void* ptr = std::malloc(count == 0 ? 1 : count))
+	{
+		return ptr;
+	}
+
+	throw std::bad_alloc();
+}
+
+// GCC sees the frees inlined into places where the memory came from operator new and doesn't realize it's this one.
+#if defined (__GNUC__) && !defined (__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+#if defined (__GNUC__) && !defined (__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// The magnitude of a number as 64-bit words. Wide tests divide through a LargeIntView of these,
+// since the byte at a time division takes ages on numbers of hundreds of limbs.
+static std::vector<uint64_t> to_words(const LargeInt& num)
+{
+	std::vector<uint64_t> words(num.export_size(sizeof(uint64_t)));
+	num.export_bits(std::span<uint64_t>(words));
+	return words;
+}
+
 void self_test_addition()
 {
 	using namespace std;
@@ -776,7 +846,13 @@ void self_test_bitshift()
 				LargeInt largeIntResultA = largeIntA << numB;
 				LargeInt largeIntResultB = largeIntA >> numB;
 
-				if (LargeInt(resultA) != largeIntResultA || LargeInt(resultB) != largeIntResultB)
+				// A negative count shifts the other way, all the way down to INT64_MIN.
+				LargeInt largeIntResultC = largeIntA >> -numB;
+				LargeInt largeIntResultD = largeIntA << -numB;
+				LargeInt largeIntResultE = largeIntA << INT64_MIN;
+
+				if (LargeInt(resultA) != largeIntResultA || LargeInt(resultB) != largeIntResultB
+					|| LargeInt(resultA) != largeIntResultC || LargeInt(resultB) != largeIntResultD || LargeInt(numA >> 63) != largeIntResultE)
 				{
 					if (*num_failed_tests < max_reported_errors)
 					{
@@ -840,11 +916,20 @@ void self_test_bitshift()
 
 				LargeInt largeIntResultA = largeIntA << numB;
 				LargeInt largeIntResultB = largeIntA >> numB;
+				LargeInt largeIntResultC = largeIntA >> -numB;
+				LargeInt largeIntResultD = largeIntA << -numB;
+				LargeInt largeIntResultE = largeIntA << INT64_MIN;
 
 				cout << "Expected: " << numA << " << " << numB << " = " << resultA
 					<< ", " << numA << " >> " << numB << " = " << resultB
+					<< ", " << numA << " >> " << -numB << " = " << resultA
+					<< ", " << numA << " << " << -numB << " = " << resultB
+					<< ", " << numA << " << " << INT64_MIN << " = " << (numA >> 63)
 					<< ", Got: " << largeIntA << " << " << numB << " = " << largeIntResultA
-					<< ", " << largeIntA << " >> " << numB << " = " << largeIntResultB << endl;
+					<< ", " << largeIntA << " >> " << numB << " = " << largeIntResultB
+					<< ", " << largeIntA << " >> " << -numB << " = " << largeIntResultC
+					<< ", " << largeIntA << " << " << -numB << " = " << largeIntResultD
+					<< ", " << largeIntA << " << " << INT64_MIN << " = " << largeIntResultE << endl;
 			}
 		}
 	}
@@ -951,3 +1036,3067 @@ void self_test_unary()
 		}
 	}
 }
+
+void self_test_gcd()
+{
+	using namespace std;
+
+	cout << "\nRunning gcd self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT16_MIN;
+	constexpr int32_t stopA = INT16_MAX + 1;
+	constexpr int32_t startB = INT16_MIN;
+	constexpr int32_t stopB = INT16_MAX + 1;
+
+	// Every 16th a also gets a pair of random wide numbers, 3 to 258 limbs, so the Lehmer and half-gcd paths run too.
+	// They share a random factor, which their cofactors then can't have. Returns the function that failed, or nullptr if they all passed.
+	auto check_wide = [](int64_t seed) -> const char*
+	{
+		mt19937_64 generator(static_cast<uint64_t>(seed));
+
+		const size_t limbs = 3 + static_cast<size_t>((seed >> 4) & 255);
+		const LargeInt common = LargeInt::random_bits(32 * limbs, generator) + 1;
+		LargeInt largeIntA = common * LargeInt::random_bits(32 * limbs, generator);
+		LargeInt largeIntB = common * LargeInt::random_bits(32 * limbs - static_cast<size_t>(seed & 63), generator);
+
+		if (seed & 1)
+		{
+			largeIntA = -largeIntA;
+		}
+
+		if (seed & 2)
+		{
+			largeIntB = -largeIntB;
+		}
+
+		const LargeInt largeIntResult = LargeInt::gcd(largeIntA, largeIntB);
+		const vector<uint64_t> result_words = to_words(largeIntResult);
+		const vector<uint64_t> common_words = to_words(common);
+		const LargeIntView result_view = LargeIntView(span<const uint64_t>(result_words));
+
+		if (largeIntResult <= 0 || largeIntA % result_view != 0 || largeIntB % result_view != 0 || largeIntResult % LargeIntView(span<const uint64_t>(common_words)) != 0
+			|| LargeInt::gcd(largeIntA / result_view, largeIntB / result_view) != 1)
+		{
+			return "gcd";
+		}
+
+		auto [largeIntResultC, largeIntS, largeIntT] = LargeInt::gcdext(largeIntA, largeIntB);
+
+		if (largeIntResultC != largeIntResult || largeIntS * largeIntA + largeIntT * largeIntB != largeIntResult)
+		{
+			return "gcdext";
+		}
+
+		// The cofactors are coprime, so one is invertible modulo the other
+		const LargeInt cofactorA = largeIntA / result_view;
+		const LargeInt modulus = (largeIntB / result_view).abs();
+		const vector<uint64_t> modulus_words = to_words(modulus);
+
+		if (modulus > 1)
+		{
+			const LargeInt inverse = LargeInt::invert(cofactorA, modulus);
+			LargeInt product = (cofactorA * inverse) % LargeIntView(span<const uint64_t>(modulus_words));
+
+			if (product < 0)
+			{
+				product += modulus;
+			}
+
+			if (inverse < 0 || inverse >= modulus || product != 1)
+			{
+				return "invert";
+			}
+		}
+
+		if (largeIntResult != 1)
+		{
+			try
+			{
+				LargeInt::invert(largeIntA, largeIntB);
+				return "invert of a number that isn't coprime";
+			}
+			catch (const LargeInt::not_invertible&)
+			{
+			}
+		}
+
+		return nullptr;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check_wide](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests, vector<int64_t>* failed_wide_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			if (a % 16 == 0 && check_wide(a) != nullptr)
+			{
+				if (*num_failed_tests < max_reported_errors)
+				{
+					failed_wide_tests->push_back(a);
+				}
+				(*num_failed_tests)++;
+			}
+
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				const int64_t resultA = gcd(numA, numB);
+				const int64_t resultB = lcm(numA, numB);
+
+				LargeInt largeIntA = LargeInt(numA);
+				LargeInt largeIntB = LargeInt(numB);
+
+				LargeInt largeIntResultA = LargeInt::gcd(largeIntA, largeIntB);
+				LargeInt largeIntResultB = LargeInt::lcm(largeIntA, largeIntB);
+				auto [largeIntResultC, largeIntS, largeIntT] = LargeInt::gcdext(largeIntA, largeIntB);
+
+				if (LargeInt(resultA) != largeIntResultA || LargeInt(resultB) != largeIntResultB
+					|| LargeInt(resultA) != largeIntResultC || largeIntS * largeIntA + largeIntT * largeIntB != largeIntResultC)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+	vector<vector<int64_t>> failed_wide_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+	failed_wide_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		failed_wide_tests.push_back(vector<int64_t>());
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin()), &(*failed_wide_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) + (static_cast<uint64_t>(stopA) - startA + 15) / 16 << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_wide_tests.begin(); outer_iter != failed_wide_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				cout << "Expected: " << check_wide(*inner_iter) << " to hold for the wide numbers seeded from a = " << *inner_iter << endl;
+			}
+		}
+
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const int64_t resultA = gcd(numA, numB);
+				const int64_t resultB = lcm(numA, numB);
+
+				LargeInt largeIntA = LargeInt(numA);
+				LargeInt largeIntB = LargeInt(numB);
+
+				LargeInt largeIntResultA = LargeInt::gcd(largeIntA, largeIntB);
+				LargeInt largeIntResultB = LargeInt::lcm(largeIntA, largeIntB);
+				auto [largeIntResultC, largeIntS, largeIntT] = LargeInt::gcdext(largeIntA, largeIntB);
+
+				cout << "Expected: gcd(" << numA << ", " << numB << ") = " << resultA
+					<< ", lcm(" << numA << ", " << numB << ") = " << resultB
+					<< ", Got: gcd(" << largeIntA << ", " << largeIntB << ") = " << largeIntResultA
+					<< ", lcm(" << largeIntA << ", " << largeIntB << ") = " << largeIntResultB
+					<< ", gcdext(" << largeIntA << ", " << largeIntB << ") = " << largeIntResultC
+					<< " = " << largeIntS << " * " << largeIntA << " + " << largeIntT << " * " << largeIntB << endl;
+			}
+		}
+	}
+}
+
+void self_test_bits()
+{
+	using namespace std;
+
+	cout << "\nRunning bit query self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 5;
+	constexpr int32_t stopA = INT32_MAX >> 5;
+	constexpr int8_t startB = 0;
+	constexpr int8_t stopB = 40;
+
+	// The bytes of a number with b more sign bytes on top than it needs, which the byte vector constructor has to trim off.
+	auto padded_bytes = [](int64_t num, int64_t b)
+	{
+		vector<uint8_t> bytes(sizeof(num) + static_cast<size_t>(b), (num < 0 ? UINT8_MAX : 0));
+
+		for (size_t i = 0; i < sizeof(num); i++)
+		{
+			bytes[i] = static_cast<uint8_t>(static_cast<uint64_t>(num) >> (8 * i));
+		}
+
+		return bytes;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&padded_bytes](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				const uint64_t magnitude = static_cast<uint64_t>(numA < 0 ? ~numA : numA);
+				const size_t resultA = static_cast<size_t>(bit_width(magnitude));
+				const size_t resultB = static_cast<size_t>(popcount(magnitude));
+				const size_t resultC = (numA == 0 ? SIZE_MAX : static_cast<size_t>(countr_zero(static_cast<uint64_t>(numA))));
+				const bool resultD = ((numA >> numB) & 1) != 0;
+				const int64_t resultE = numA | (1ll << numB);
+				const int64_t resultF = numA & ~(1ll << numB);
+				const int64_t resultG = numA ^ (1ll << numB);
+
+				LargeInt largeIntA = LargeInt(numA);
+
+				const size_t largeIntResultA = largeIntA.bit_length();
+				const size_t largeIntResultB = largeIntA.popcount();
+				const size_t largeIntResultC = largeIntA.countr_zero();
+				const bool largeIntResultD = largeIntA.test_bit(numB);
+				LargeInt largeIntResultE = LargeInt(largeIntA).set_bit(numB);
+				LargeInt largeIntResultF = LargeInt(largeIntA).clear_bit(numB);
+				LargeInt largeIntResultG = LargeInt(largeIntA).flip_bit(numB);
+				const LargeInt largeIntResultH = LargeInt(padded_bytes(numA, numB));
+
+				if (resultA != largeIntResultA || resultB != largeIntResultB || resultC != largeIntResultC || resultD != largeIntResultD
+					|| LargeInt(resultE) != largeIntResultE || LargeInt(resultF) != largeIntResultF || LargeInt(resultG) != largeIntResultG
+					|| resultA != largeIntResultH.bit_length() || !largeIntResultH.is_exactly_equal(largeIntA) || largeIntResultH.serialized_size() != largeIntA.serialized_size())
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const uint64_t magnitude = static_cast<uint64_t>(numA < 0 ? ~numA : numA);
+				const size_t resultA = static_cast<size_t>(bit_width(magnitude));
+				const size_t resultB = static_cast<size_t>(popcount(magnitude));
+				const size_t resultC = (numA == 0 ? SIZE_MAX : static_cast<size_t>(countr_zero(static_cast<uint64_t>(numA))));
+				const bool resultD = ((numA >> numB) & 1) != 0;
+				const int64_t resultE = numA | (1ll << numB);
+				const int64_t resultF = numA & ~(1ll << numB);
+				const int64_t resultG = numA ^ (1ll << numB);
+
+				LargeInt largeIntA = LargeInt(numA);
+
+				const size_t largeIntResultA = largeIntA.bit_length();
+				const size_t largeIntResultB = largeIntA.popcount();
+				const size_t largeIntResultC = largeIntA.countr_zero();
+				const bool largeIntResultD = largeIntA.test_bit(numB);
+				LargeInt largeIntResultE = LargeInt(largeIntA).set_bit(numB);
+				LargeInt largeIntResultF = LargeInt(largeIntA).clear_bit(numB);
+				LargeInt largeIntResultG = LargeInt(largeIntA).flip_bit(numB);
+				const LargeInt largeIntResultH = LargeInt(padded_bytes(numA, numB));
+
+				cout << "Expected: bit_length(" << numA << ") = " << resultA
+					<< ", popcount(" << numA << ") = " << resultB
+					<< ", countr_zero(" << numA << ") = " << resultC
+					<< ", test_bit(" << numA << ", " << numB << ") = " << resultD
+					<< ", set_bit(" << numA << ", " << numB << ") = " << resultE
+					<< ", clear_bit(" << numA << ", " << numB << ") = " << resultF
+					<< ", flip_bit(" << numA << ", " << numB << ") = " << resultG
+					<< ", bit_length of " << numA << " padded with " << numB << " sign bytes = " << resultA
+					<< ", Got: bit_length(" << largeIntA << ") = " << largeIntResultA
+					<< ", popcount(" << largeIntA << ") = " << largeIntResultB
+					<< ", countr_zero(" << largeIntA << ") = " << largeIntResultC
+					<< ", test_bit(" << largeIntA << ", " << numB << ") = " << largeIntResultD
+					<< ", set_bit(" << largeIntA << ", " << numB << ") = " << largeIntResultE
+					<< ", clear_bit(" << largeIntA << ", " << numB << ") = " << largeIntResultF
+					<< ", flip_bit(" << largeIntA << ", " << numB << ") = " << largeIntResultG
+					<< ", bit_length of " << largeIntResultH << " padded with " << numB << " sign bytes = " << largeIntResultH.bit_length() << endl;
+			}
+		}
+	}
+}
+
+void self_test_combinatorics()
+{
+	using namespace std;
+
+	cout << "\nRunning combinatorics self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	// No built in types to compare against, so this checks the recurrences instead:
+	// Pascal's rule for binomials, n! = n * (n - 1)!, F(n + 1) = F(n) + F(n - 1) and L(n) = F(n - 1) + F(n + 1).
+	constexpr int32_t startA = 1;
+	constexpr int32_t stopA = 800;
+	constexpr int32_t startB = 0;
+	constexpr int32_t stopB = 800;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				uint64_t numA = static_cast<uint64_t>(a);
+				uint64_t numB = static_cast<uint64_t>(b);
+
+				const LargeInt resultA = (numB == 0 ? LargeInt(1) : LargeInt::binomial(numA - 1, numB - 1) + LargeInt::binomial(numA - 1, numB));
+				const LargeInt largeIntResultA = LargeInt::binomial(numA, numB);
+
+				bool failed = resultA != largeIntResultA;
+
+				// The sequences only depend on a, no point checking them again for every b
+				if (numB == 0)
+				{
+					failed = failed || LargeInt::factorial(numA - 1) * LargeInt(numA) != LargeInt::factorial(numA)
+						|| LargeInt::fibonacci(numA) + LargeInt::fibonacci(numA - 1) != LargeInt::fibonacci(numA + 1)
+						|| LargeInt::fibonacci(numA - 1) + LargeInt::fibonacci(numA + 1) != LargeInt::lucas(numA);
+				}
+
+				if (failed)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const uint64_t numA = inner_iter->first;
+				const uint64_t numB = inner_iter->second;
+
+				const LargeInt resultA = (numB == 0 ? LargeInt(1) : LargeInt::binomial(numA - 1, numB - 1) + LargeInt::binomial(numA - 1, numB));
+
+				cout << "Expected: binomial(" << numA << ", " << numB << ") = " << resultA
+					<< ", factorial(" << numA << ") = " << LargeInt::factorial(numA - 1) * LargeInt(numA)
+					<< ", fibonacci(" << numA + 1 << ") = " << LargeInt::fibonacci(numA) + LargeInt::fibonacci(numA - 1)
+					<< ", lucas(" << numA << ") = " << LargeInt::fibonacci(numA - 1) + LargeInt::fibonacci(numA + 1)
+					<< ", Got: binomial(" << numA << ", " << numB << ") = " << LargeInt::binomial(numA, numB)
+					<< ", factorial(" << numA << ") = " << LargeInt::factorial(numA)
+					<< ", fibonacci(" << numA + 1 << ") = " << LargeInt::fibonacci(numA + 1)
+					<< ", lucas(" << numA << ") = " << LargeInt::lucas(numA) << endl;
+			}
+		}
+	}
+}
+
+void self_test_primes()
+{
+	using namespace std;
+
+	cout << "\nRunning primality self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = -1024;
+	constexpr int32_t stopA = 1 << 22;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	// Plain old sieve of Eratosthenes to check against, with some room at the end for next_prime.
+	vector<bool> sieve(stopA + 1024, true);
+	sieve[0] = false;
+	sieve[1] = false;
+
+	for (size_t i = 2; i * i < sieve.size(); i++)
+	{
+		if (sieve[i])
+		{
+			for (size_t j = i * i; j < sieve.size(); j += i)
+			{
+				sieve[j] = false;
+			}
+		}
+	}
+
+	// Every 4096th a also gets a random prime of 2 to 9 limbs, which the sieve can't reach, and a couple of composites made from it.
+	// Both overloads of is_probable_prime have to agree with BPSW. Returns the check that failed, or nullptr if they all passed.
+	auto check_wide = [](int64_t seed) -> const char*
+	{
+		mt19937_64 generator(static_cast<uint64_t>(seed));
+
+		const size_t bits = 1 + static_cast<size_t>(seed >> 12) % 448;
+		const LargeInt prime = LargeInt::next_prime((LargeInt(1) << 64) + LargeInt::random_bits(bits, generator));
+		const LargeInt factor = LargeInt::next_prime(LargeInt::random_bits(64, generator));
+
+		if (!prime.is_probable_prime_bpsw())
+		{
+			return "next_prime to give a prime";
+		}
+
+		if (!prime.is_probable_prime() || !prime.is_probable_prime(25, generator))
+		{
+			return "is_probable_prime of a prime";
+		}
+
+		for (const LargeInt& composite : { prime * factor, prime * prime })
+		{
+			if (composite.is_probable_prime() || composite.is_probable_prime(25, generator) || composite.is_probable_prime_bpsw())
+			{
+				return "is_probable_prime of a composite";
+			}
+		}
+
+		return nullptr;
+	};
+
+	auto single_test = [&sieve, &check_wide](int32_t start, uint32_t step_size, vector<int64_t>* failed_tests, uint64_t* num_failed_tests, vector<int64_t>* failed_wide_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			if (a % 4096 == 0 && check_wide(a) != nullptr)
+			{
+				if (*num_failed_tests < max_reported_errors)
+				{
+					failed_wide_tests->push_back(a);
+				}
+				(*num_failed_tests)++;
+			}
+
+			int64_t numA = static_cast<int64_t>(a);
+
+			int64_t next = max<int64_t>(numA + 1, 2);
+
+			while (!sieve[next])
+			{
+				next++;
+			}
+
+			const bool resultA = numA >= 0 && sieve[numA];
+			const int64_t resultB = next;
+
+			LargeInt largeIntA = LargeInt(numA);
+
+			const bool largeIntResultA = largeIntA.is_probable_prime(2);
+			const bool largeIntResultB = largeIntA.is_probable_prime_bpsw();
+			LargeInt largeIntResultC = LargeInt::next_prime(largeIntA);
+
+			if (resultA != largeIntResultA || resultA != largeIntResultB || LargeInt(resultB) != largeIntResultC)
+			{
+				if (*num_failed_tests < max_reported_errors)
+				{
+					failed_tests->push_back(numA);
+				}
+				(*num_failed_tests)++;
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<int64_t>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+	vector<vector<int64_t>> failed_wide_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+	failed_wide_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<int64_t>());
+		num_failed_tests.push_back(0);
+		failed_wide_tests.push_back(vector<int64_t>());
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin()), &(*failed_wide_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << static_cast<uint64_t>(stopA) - startA + static_cast<uint64_t>(stopA) / 4096 << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_wide_tests.begin(); outer_iter != failed_wide_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				cout << "Expected: " << check_wide(*inner_iter) << " to hold for the wide numbers seeded from a = " << *inner_iter << endl;
+			}
+		}
+
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = *inner_iter;
+
+				int64_t next = max<int64_t>(numA + 1, 2);
+
+				while (!sieve[next])
+				{
+					next++;
+				}
+
+				const bool resultA = numA >= 0 && sieve[numA];
+				const int64_t resultB = next;
+
+				LargeInt largeIntA = LargeInt(numA);
+
+				const bool largeIntResultA = largeIntA.is_probable_prime(2);
+				const bool largeIntResultB = largeIntA.is_probable_prime_bpsw();
+				LargeInt largeIntResultC = LargeInt::next_prime(largeIntA);
+
+				cout << "Expected: is_probable_prime(" << numA << ") = " << resultA
+					<< ", is_probable_prime_bpsw(" << numA << ") = " << resultA
+					<< ", next_prime(" << numA << ") = " << resultB
+					<< ", Got: is_probable_prime(" << largeIntA << ") = " << largeIntResultA
+					<< ", is_probable_prime_bpsw(" << largeIntA << ") = " << largeIntResultB
+					<< ", next_prime(" << largeIntA << ") = " << largeIntResultC << endl;
+			}
+		}
+	}
+}
+
+void self_test_random()
+{
+	using namespace std;
+
+	cout << "\nRunning wide random self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	// Exhaustive ranges can't reach past a few bytes, so this throws random numbers of up to max_bits at identities instead.
+	constexpr int32_t startA = 0;
+	constexpr int32_t stopA = 1 << 16;
+	constexpr size_t max_bits = 512;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	// Every identity that should hold for a and b
+	auto check = [](const LargeInt& a, const LargeInt& b, size_t shift)
+	{
+		bool passed = (a + b) - b == a && (a - b) + b == a && (a << shift) >> shift == a && (a & b) + (a | b) == a + b;
+
+		if (b != LargeInt(0))
+		{
+			const LargeInt g = LargeInt::gcd(a, b);
+			passed = passed && (a * b) / b == a && (a / b) * b + a % b == a && (a % b).abs() < b.abs() && a % g == LargeInt(0) && b % g == LargeInt(0);
+		}
+
+		return passed;
+	};
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<LargeInt, LargeInt>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		mt19937_64 generator(start);
+
+		for (int32_t i = start; i < stopA; i += step_size)
+		{
+			LargeInt a = LargeInt::random_bits(generator() % max_bits + 1, generator);
+			LargeInt b = LargeInt::random_bits(generator() % max_bits + 1, generator);
+			const size_t shift = generator() % max_bits;
+
+			if (generator() & 1)
+			{
+				a = -a;
+			}
+
+			if (generator() & 1)
+			{
+				b = -b;
+			}
+
+			const LargeInt bound = b.abs() + LargeInt(1);
+			const LargeInt below = LargeInt::random_below(bound, generator);
+
+			if (!check(a, b, shift) || below < LargeInt(0) || below >= bound)
+			{
+				if (*num_failed_tests < max_reported_errors)
+				{
+					failed_tests->push_back(make_pair(a, b));
+				}
+				(*num_failed_tests)++;
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<LargeInt, LargeInt>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<LargeInt, LargeInt>>());
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << static_cast<uint64_t>(stopA) - startA << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const LargeInt& a = inner_iter->first;
+				const LargeInt& b = inner_iter->second;
+
+				cout << "Failed with a = " << a << ", b = " << b
+					<< ": a + b = " << a + b
+					<< ", a - b = " << a - b
+					<< ", a * b = " << a * b;
+
+				if (b != LargeInt(0))
+				{
+					cout << ", a / b = " << a / b
+						<< ", a % b = " << a % b
+						<< ", gcd(a, b) = " << LargeInt::gcd(a, b);
+				}
+
+				cout << endl;
+			}
+		}
+	}
+}
+
+void self_test_modint()
+{
+	using namespace std;
+
+	cout << "\nRunning ModInt self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	// a goes over odd moduli, b over the values
+	constexpr int32_t startA = 1;
+	constexpr int32_t stopA = 1024;
+	constexpr int32_t startB = INT16_MIN >> 4;
+	constexpr int32_t stopB = (INT16_MAX >> 4) + 1;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto reduce = [](int64_t value, int64_t modulus)
+	{
+		return (value % modulus + modulus) % modulus;
+	};
+
+	auto power = [&reduce](int64_t base, int64_t exponent, int64_t modulus)
+	{
+		int64_t result = reduce(1, modulus);
+
+		for (int64_t i = 0; i < exponent; i++)
+		{
+			result = reduce(result * base, modulus);
+		}
+
+		return result;
+	};
+
+	auto single_test = [&reduce, &power](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			if ((a & 1) == 0)
+			{
+				continue;
+			}
+
+			const int64_t numA = static_cast<int64_t>(a);
+			const shared_ptr<const ModInt::modulus> modulus = ModInt::make_modulus(LargeInt(numA));
+
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				const int64_t numB = static_cast<int64_t>(b);
+				const int64_t numC = numB * 31 + 7;
+				const int64_t exponent = (numB < 0 ? -numB : numB) % 64;
+
+				const int64_t resultA = reduce(numB + numC, numA);
+				const int64_t resultB = reduce(numB - numC, numA);
+				const int64_t resultC = reduce(reduce(numB, numA) * reduce(numC, numA), numA);
+				const int64_t resultD = power(reduce(numB, numA), exponent, numA);
+				const bool invertible = gcd(numB, numA) == 1;
+
+				const ModInt modIntB = ModInt(LargeInt(numB), modulus);
+				const ModInt modIntC = ModInt(LargeInt(numC), modulus);
+
+				bool failed = modIntB.get_value() != LargeInt(reduce(numB, numA))
+					|| (modIntB + modIntC).get_value() != LargeInt(resultA)
+					|| (modIntB - modIntC).get_value() != LargeInt(resultB)
+					|| (modIntB * modIntC).get_value() != LargeInt(resultC)
+					|| modIntB.pow(LargeInt(exponent)).get_value() != LargeInt(resultD);
+
+				if (invertible)
+				{
+					failed = failed || (modIntB * modIntB.inverse()).get_value() != LargeInt(reduce(1, numA));
+				}
+
+				if (failed)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) / 2 * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+				const int64_t numC = numB * 31 + 7;
+				const int64_t exponent = (numB < 0 ? -numB : numB) % 64;
+
+				const shared_ptr<const ModInt::modulus> modulus = ModInt::make_modulus(LargeInt(numA));
+				const ModInt modIntB = ModInt(LargeInt(numB), modulus);
+				const ModInt modIntC = ModInt(LargeInt(numC), modulus);
+
+				cout << "Modulus " << numA << ", expected: " << numB << " = " << reduce(numB, numA)
+					<< ", " << numB << " + " << numC << " = " << reduce(numB + numC, numA)
+					<< ", " << numB << " - " << numC << " = " << reduce(numB - numC, numA)
+					<< ", " << numB << " * " << numC << " = " << reduce(reduce(numB, numA) * reduce(numC, numA), numA)
+					<< ", " << numB << " ^ " << exponent << " = " << power(reduce(numB, numA), exponent, numA)
+					<< ", Got: " << modIntB.get_value()
+					<< ", " << (modIntB + modIntC).get_value()
+					<< ", " << (modIntB - modIntC).get_value()
+					<< ", " << (modIntB * modIntC).get_value()
+					<< ", " << modIntB.pow(LargeInt(exponent)).get_value() << endl;
+			}
+		}
+	}
+}
+
+void self_test_parse()
+{
+	using namespace std;
+
+	cout << "\nRunning string parsing self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 5;
+	constexpr int32_t stopA = INT32_MAX >> 5;
+	constexpr int8_t startB = 2;
+	constexpr int8_t stopB = 37;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		char buffer[64];
+
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				const string_view str(buffer, to_chars(buffer, buffer + sizeof(buffer), numA, b).ptr);
+
+				LargeInt largeIntResult = LargeInt(str, b);
+
+				if (LargeInt(numA) != largeIntResult)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				char buffer[64];
+				const string_view str(buffer, to_chars(buffer, buffer + sizeof(buffer), numA, static_cast<int>(numB)).ptr);
+
+				cout << "Expected: \"" << str << "\" in base " << numB << " = " << numA << ", Got: " << LargeInt(str, static_cast<int>(numB)) << endl;
+			}
+		}
+	}
+}
+
+void self_test_to_string()
+{
+	using namespace std;
+
+	cout << "\nRunning string conversion self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 5;
+	constexpr int32_t stopA = INT32_MAX >> 5;
+	constexpr int8_t startB = 2;
+	constexpr int8_t stopB = 37;
+
+	// Every 4096th a also round trips a random string of thousands of digits, so the radix powers and their reciprocals get used.
+	// The number is checked against the digits modulo a prime too, so a conversion that's wrong both ways can't slip through.
+	// Returns true if it all matched.
+	auto check_wide = [](int64_t seed) -> bool
+	{
+		constexpr char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+		static constexpr uint64_t prime = 1000000007;
+
+		mt19937_64 generator(static_cast<uint64_t>(seed));
+
+		const int base = static_cast<int>(2 + (static_cast<uint64_t>(seed) >> 12) % 35);
+		string digits(1000 + generator() % 20000, '0');
+		uint64_t residue = 0;
+
+		for (size_t i = 0; i < digits.size(); i++)
+		{
+			const uint64_t digit = (i == 0 ? 1 + generator() % (base - 1) : generator() % base);
+			digits[i] = digit_chars[digit];
+			residue = (residue * base + digit) % prime;
+		}
+
+		const LargeInt largeInt = LargeInt::from_string(digits, base);
+
+		// Through a view, since the byte at a time modulo would take seconds on something this size
+		return largeInt % LargeIntView(span<const uint64_t>(&prime, 1)) == LargeInt(residue) && largeInt.to_string(base) == digits && (-largeInt).to_string(base) == "-" + digits;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check_wide](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		char buffer[64];
+
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			if (a % 4096 == 0 && !check_wide(a))
+			{
+				if (*num_failed_tests < max_reported_errors)
+				{
+					failed_tests->push_back(make_pair(static_cast<int64_t>(a), int64_t(0)));
+				}
+				(*num_failed_tests)++;
+			}
+
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				const string_view str(buffer, to_chars(buffer, buffer + sizeof(buffer), numA, b).ptr);
+
+				const string largeIntResult = LargeInt(numA).to_string(b);
+
+				if (str != largeIntResult)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) + (static_cast<uint64_t>(stopA) - startA) / 4096 << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				if (numB == 0)
+				{
+					cout << "Expected: the random digits seeded from a = " << numA << " to round trip" << endl;
+					continue;
+				}
+
+				char buffer[64];
+				const string_view str(buffer, to_chars(buffer, buffer + sizeof(buffer), numA, static_cast<int>(numB)).ptr);
+
+				cout << "Expected: " << numA << " in base " << numB << " = \"" << str << "\", Got: \"" << LargeInt(numA).to_string(static_cast<int>(numB)) << "\"" << endl;
+			}
+		}
+	}
+}
+
+void self_test_format()
+{
+	using namespace std;
+
+	cout << "\nRunning format self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	static constexpr string_view format_specs[] = { "{}", "{:+}", "{: }", "{:#x}", "{:#X}", "{:#b}", "{:#B}", "{:#o}", "{:o}", "{:>12}", "{:*<10x}", "{:-^30b}", "{:08}", "{:#010x}", "{:+020d}" };
+
+	// Past the format specs, b picks one of these ways of setting up a stream for operator<< instead.
+	static constexpr string_view stream_specs[] = { "internal *", "internal showpos #", "internal showbase hex *", "internal showbase uppercase hex *",
+		"internal showbase oct _", "left showbase hex .", "internal 0", "failbit already set", "streambuf that can't be written to" };
+
+	// The default overflow fails every write.
+	struct failing_buffer : streambuf
+	{
+	};
+
+	constexpr int32_t startA = INT32_MIN >> 5;
+	constexpr int32_t stopA = INT32_MAX >> 5;
+	constexpr int8_t startB = 0;
+	constexpr int8_t stopB = static_cast<int8_t>(size(format_specs) + size(stream_specs));
+
+	// Formats an int64_t or a LargeInt with format spec or stream setup b. Hex and octal streams get the magnitude,
+	// since the built in integers write negative numbers there as unsigned. The last two stream setups also give the stream's state.
+	auto formatted = [](const auto& num, int64_t b) -> string
+	{
+		if (b < static_cast<int64_t>(size(format_specs)))
+		{
+			return vformat(format_specs[b], make_format_args(num));
+		}
+
+		ostringstream stream;
+
+		switch (b - static_cast<int64_t>(size(format_specs)))
+		{
+		case 0: stream << setfill('*') << internal << setw(12) << num; break;
+		case 1: stream << setfill('#') << internal << showpos << setw(12) << num; break;
+		case 2: stream << setfill('*') << internal << showbase << hex << setw(12) << (num < 0 ? -num : num); break;
+		case 3: stream << setfill('*') << internal << showbase << uppercase << hex << setw(14) << (num < 0 ? -num : num); break;
+		case 4: stream << setfill('_') << internal << showbase << oct << setw(14) << (num < 0 ? -num : num); break;
+		case 5: stream << setfill('.') << left << showbase << hex << setw(12) << (num < 0 ? -num : num); break;
+		case 6: stream << setfill('0') << internal << setw(12) << num; break;
+		case 7:
+			stream.setstate(ios_base::failbit);
+			stream << num;
+			return stream.str() + (stream.bad() ? " bad" : " not bad");
+		default:
+		{
+			failing_buffer buffer;
+			ostream failing_stream(&buffer);
+			failing_stream << num;
+			return (failing_stream.bad() ? "bad" : "not bad");
+		}
+		}
+
+		return stream.str();
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&formatted](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				const LargeInt largeIntA = LargeInt(numA);
+				const string str = formatted(numA, numB);
+
+				const string largeIntResult = formatted(largeIntA, numB);
+
+				if (str != largeIntResult)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const LargeInt largeIntA = LargeInt(numA);
+				const string_view spec = (numB < static_cast<int64_t>(size(format_specs)) ? format_specs[numB] : stream_specs[numB - size(format_specs)]);
+
+				cout << "Expected: " << numA << " formatted with \"" << spec << "\" = \"" << formatted(numA, numB) << "\", Got: \"" << formatted(largeIntA, numB) << "\"" << endl;
+			}
+		}
+	}
+}
+
+void self_test_chars()
+{
+	using namespace std;
+
+	cout << "\nRunning to_chars and from_chars self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 5;
+	constexpr int32_t stopA = INT32_MAX >> 5;
+	constexpr int8_t startB = 2;
+	constexpr int8_t stopB = 37;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		char buffer[64];
+		char largeIntBuffer[64];
+
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				const string_view str(buffer, to_chars(buffer, buffer + sizeof(buffer), numA, b).ptr);
+
+				const LargeInt largeIntA = LargeInt(numA);
+				const to_chars_result largeIntResult = largeIntA.to_chars(largeIntBuffer, largeIntBuffer + sizeof(largeIntBuffer), b);
+
+				LargeInt parsed;
+				const from_chars_result parseResult = LargeInt::from_chars(str.data(), str.data() + str.size(), parsed, b);
+
+				if (largeIntResult.ec != errc() || str != string_view(largeIntBuffer, largeIntResult.ptr) || parseResult.ptr != str.data() + str.size() || parsed != largeIntA)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				char buffer[64];
+				const string_view str(buffer, to_chars(buffer, buffer + sizeof(buffer), numA, static_cast<int>(numB)).ptr);
+
+				char largeIntBuffer[64];
+				const to_chars_result largeIntResult = LargeInt(numA).to_chars(largeIntBuffer, largeIntBuffer + sizeof(largeIntBuffer), static_cast<int>(numB));
+
+				LargeInt parsed;
+				LargeInt::from_chars(str.data(), str.data() + str.size(), parsed, static_cast<int>(numB));
+
+				cout << "Expected: " << numA << " in base " << numB << " = \"" << str << "\", Got: \"" << string_view(largeIntBuffer, largeIntResult.ptr) << "\" and " << parsed << endl;
+			}
+		}
+	}
+}
+
+void self_test_serialize()
+{
+	using namespace std;
+
+	cout << "\nRunning serialization self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 5;
+	constexpr int32_t stopA = INT32_MAX >> 5;
+	constexpr int8_t startB = 0;
+	constexpr int8_t stopB = 12;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		vector<uint8_t> buffer;
+
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				// Shifted up by more and more so both the varint and the raw limb encodings get used.
+				const LargeInt largeIntA = LargeInt(numA) << (numB * 16);
+
+				buffer.clear();
+				largeIntA.serialize(back_inserter(buffer));
+
+				span<const uint8_t> data(buffer);
+				const LargeInt largeIntResult = LargeInt::deserialize(data);
+
+				if (largeIntResult != largeIntA || !data.empty() || buffer.size() != largeIntA.serialized_size())
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const LargeInt largeIntA = LargeInt(numA) << (numB * 16);
+
+				vector<uint8_t> buffer;
+				largeIntA.serialize(back_inserter(buffer));
+
+				span<const uint8_t> data(buffer);
+
+				cout << "Expected: " << largeIntA << " in " << largeIntA.serialized_size() << " bytes, Got: " << LargeInt::deserialize(data) << " in " << buffer.size() << " bytes" << endl;
+			}
+		}
+	}
+}
+
+void self_test_file()
+{
+	using namespace std;
+
+	cout << "\nRunning bulk file self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	// Every thread writes its share of a to its own file, shifted up by b * 61 bits so there's a mix of sizes, then reads it all back.
+	constexpr int32_t startA = INT16_MIN;
+	constexpr int32_t stopA = INT16_MAX + 1;
+	constexpr int32_t startB = 0;
+	constexpr int32_t stopB = 8;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto value = [](int64_t numA, int64_t numB)
+	{
+		return LargeInt(numA) << (numB * 61);
+	};
+
+	auto single_test = [&value](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		const string path = (filesystem::temp_directory_path() / format("large_variables_self_test_{}.bin", start)).string();
+
+		{
+			LargeIntFileWriter writer(path);
+
+			for (int32_t a = start; a < stopA; a += step_size)
+			{
+				for (int32_t b = startB; b < stopB; b++)
+				{
+					writer.write(value(a, b));
+				}
+			}
+		}
+
+		{
+			const LargeIntFileReader reader(path);
+			size_t i = 0;
+
+			for (int32_t a = start; a < stopA; a += step_size)
+			{
+				for (int32_t b = startB; b < stopB; b++, i++)
+				{
+					int64_t numA = static_cast<int64_t>(a);
+					int64_t numB = static_cast<int64_t>(b);
+
+					const LargeInt largeIntA = value(numA, numB);
+					bool failed = i >= reader.size() || reader.get(i) != largeIntA;
+
+					if (!failed && (endian::native == endian::little))
+					{
+						failed = largeIntA != reader.view(i);
+					}
+
+					if (failed)
+					{
+						if (*num_failed_tests < max_reported_errors)
+						{
+							failed_tests->push_back(make_pair(numA, numB));
+						}
+						(*num_failed_tests)++;
+					}
+				}
+			}
+		}
+
+		filesystem::remove(path);
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				cout << "Expected: " << value(numA, numB) << " to survive a round trip through a bulk file" << endl;
+			}
+		}
+	}
+}
+
+void self_test_float()
+{
+	using namespace std;
+
+	cout << "\nRunning float conversion self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 7;
+	constexpr int32_t stopA = INT32_MAX >> 7;
+	constexpr int8_t startB = 0;
+	constexpr int8_t stopB = 12;
+
+	// a * 2^(16b + 40) + a, which needs rounding once it's wider than a double's mantissa.
+	auto value = [](int64_t numA, int64_t numB)
+	{
+		return (LargeInt(numA) << (numB * 16 + 40)) + LargeInt(numA);
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&value](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				const LargeInt largeIntA = value(numA, numB);
+
+				// strtod rounds correctly, so the decimal string gives the expected result.
+				const double expected = strtod(largeIntA.to_string().c_str(), nullptr);
+				const double result = static_cast<double>(largeIntA);
+
+				// And the double should convert back to exactly the number it's holding.
+				const LargeInt shifted = LargeInt(numA) << (numB * 16);
+				const double exact = ldexp(static_cast<double>(numA), static_cast<int>(numB * 16));
+
+				if (result != expected || LargeInt(exact) != shifted || static_cast<double>(shifted) != exact)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const LargeInt largeIntA = value(numA, numB);
+
+				cout << "Expected: " << format("{:.17g}", strtod(largeIntA.to_string().c_str(), nullptr)) << ", Got: " << format("{:.17g}", static_cast<double>(largeIntA)) << " from " << largeIntA << endl;
+			}
+		}
+	}
+}
+
+void self_test_import()
+{
+	using namespace std;
+
+	cout << "\nRunning bit import/export self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 5;
+	constexpr int32_t stopA = INT32_MAX >> 5;
+	constexpr int8_t startB = 0;
+	constexpr int8_t stopB = 12;
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		vector<uint8_t> buffer;
+
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				// Word sizes from 1 to 12 bytes, so the byte swapped 8 byte words and the generic reversal both get used.
+				const LargeInt largeIntA = LargeInt(numA) << (numB * 16);
+				const size_t word_size = static_cast<size_t>(numB) + 1;
+				const endian endianness = (numA & 1 ? endian::big : endian::little);
+
+				buffer.assign(largeIntA.export_size(word_size) * word_size, 0);
+				const size_t words = largeIntA.export_bits(buffer, word_size, endianness);
+
+				const LargeInt largeIntResult = LargeInt::import_bits(buffer, word_size, endianness, largeIntA.is_negative());
+
+				if (largeIntResult != largeIntA || words * word_size != buffer.size())
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const LargeInt largeIntA = LargeInt(numA) << (numB * 16);
+				const size_t word_size = static_cast<size_t>(numB) + 1;
+				const endian endianness = (numA & 1 ? endian::big : endian::little);
+
+				vector<uint8_t> buffer(largeIntA.export_size(word_size) * word_size);
+				largeIntA.export_bits(buffer, word_size, endianness);
+
+				cout << "Expected: " << largeIntA << " in " << largeIntA.export_size(word_size) << " words of " << word_size << " bytes, Got: " << LargeInt::import_bits(buffer, word_size, endianness, largeIntA.is_negative()) << endl;
+			}
+		}
+	}
+}
+
+void self_test_view()
+{
+	using namespace std;
+
+	cout << "\nRunning view self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT16_MIN >> 6;
+	constexpr int32_t stopA = (INT16_MAX + 1) >> 6;
+	constexpr int32_t startB = INT16_MIN >> 6;
+	constexpr int32_t stopB = (INT16_MAX + 1) >> 6;
+
+	// Runs every operator that takes a view against the same operator taking a LargeInt.
+	// Both are shifted up so they take a few limbs. Returns the operator that didn't match, or nullptr if they all did.
+	auto check = [](int64_t numA, int64_t numB) -> const char*
+	{
+		const LargeInt largeIntA = LargeInt(numA) << 100;
+		const LargeInt largeIntB = (LargeInt(numB) << 64) + LargeInt(numB);
+
+		vector<uint64_t> limbs(largeIntB.export_size(sizeof(uint64_t)));
+		largeIntB.export_bits(span<uint64_t>(limbs));
+		const LargeIntView view(limbs, largeIntB.is_negative());
+
+		if (LargeInt(view) != largeIntB || largeIntA + view != largeIntA + largeIntB)
+		{
+			return "+";
+		}
+
+		if (largeIntA - view != largeIntA - largeIntB)
+		{
+			return "-";
+		}
+
+		if (largeIntA * view != largeIntA * largeIntB)
+		{
+			return "*";
+		}
+
+		if (numB != 0 && largeIntA / view != largeIntA / largeIntB)
+		{
+			return "/";
+		}
+
+		if (numB != 0 && largeIntA % view != largeIntA % largeIntB)
+		{
+			return "%";
+		}
+
+		if ((largeIntA & view) != (largeIntA & largeIntB))
+		{
+			return "&";
+		}
+
+		if ((largeIntA | view) != (largeIntA | largeIntB))
+		{
+			return "|";
+		}
+
+		if ((largeIntA ^ view) != (largeIntA ^ largeIntB))
+		{
+			return "^";
+		}
+
+		if ((largeIntA <=> view) != (largeIntA <=> largeIntB) || (view <=> largeIntA) != (largeIntB <=> largeIntA))
+		{
+			return "<=>";
+		}
+
+		if ((largeIntA == view) != (largeIntA == largeIntB) || largeIntB != view)
+		{
+			return "==";
+		}
+
+		return nullptr;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				if (check(numA, numB) != nullptr)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const LargeInt largeIntA = LargeInt(numA) << 100;
+				const LargeInt largeIntB = (LargeInt(numB) << 64) + LargeInt(numB);
+
+				cout << "Expected: " << largeIntA << " " << check(numA, numB) << " " << largeIntB << " to give the same result with a view of " << largeIntB << endl;
+			}
+		}
+	}
+}
+
+void self_test_stream()
+{
+	using namespace std;
+
+	cout << "\nRunning stream input self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT32_MIN >> 7;
+	constexpr int32_t stopA = INT32_MAX >> 7;
+	constexpr int8_t startB = 0;
+	constexpr int8_t stopB = 12;
+
+	// Every 16384th a also reads random numbers of thousands of digits in decimal, hex and octal, at lengths around 1, 2, 3, 5, 8 and 13
+	// times the block size (digits_per_limb * string_basecase_limbs digits), so the blocks get merged and scaled and not just read as a tail.
+	// They're checked against the digits modulo a prime as well as from_string(). Returns true if they all matched.
+	auto check_long = [](int64_t seed) -> bool
+	{
+		constexpr char digit_chars[] = "0123456789abcdef";
+		static constexpr uint64_t prime = 1000000007;
+		constexpr ios_base::fmtflags bases[] = { ios_base::dec, ios_base::hex, ios_base::oct };
+		constexpr uint64_t radixes[] = { 10, 16, 8 };
+		constexpr size_t block_sizes[] = { 19 * 32, 16 * 32, 21 * 32 };
+		constexpr size_t block_counts[] = { 1, 2, 3, 5, 8, 13 };
+
+		mt19937_64 generator(static_cast<uint64_t>(seed));
+
+		for (size_t i = 0; i < size(bases); i++)
+		{
+			for (const size_t blocks : block_counts)
+			{
+				for (size_t length = blocks * block_sizes[i] - 1; length <= blocks * block_sizes[i] + 1; length++)
+				{
+					string digits(length, '0');
+					uint64_t residue = 0;
+
+					for (size_t j = 0; j < length; j++)
+					{
+						const uint64_t digit = (j == 0 ? 1 + generator() % (radixes[i] - 1) : generator() % radixes[i]);
+						digits[j] = digit_chars[digit];
+						residue = (residue * radixes[i] + digit) % prime;
+					}
+
+					const bool negative = (generator() % 2 == 0);
+
+					stringstream stream;
+					stream.setf(bases[i], ios_base::basefield);
+					stream << (negative ? " -" : " ") << digits << " end";
+
+					LargeInt largeIntResult;
+					string rest;
+					stream >> largeIntResult >> rest;
+
+					// Through a view, since the byte at a time modulo would take seconds on something this size
+					LargeInt largeIntResidue = largeIntResult % LargeIntView(span<const uint64_t>(&prime, 1));
+
+					if (negative)
+					{
+						largeIntResidue = -largeIntResidue;
+					}
+
+					if (largeIntResidue != LargeInt(residue) || largeIntResult != LargeInt::from_string((negative ? "-" : "") + digits, static_cast<int>(radixes[i]))
+						|| rest != "end" || stream.fail())
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check_long](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			if (a % 16384 == 0 && !check_long(a))
+			{
+				if (*num_failed_tests < max_reported_errors)
+				{
+					failed_tests->push_back(make_pair(static_cast<int64_t>(a), int64_t(-1)));
+				}
+				(*num_failed_tests)++;
+			}
+
+			for (int8_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				// Written out in decimal, hex and octal in turn, with something after it that has to be left alone.
+				const LargeInt largeIntA = LargeInt(numA) << (numB * 16);
+				const ios_base::fmtflags base = (b % 3 == 0 ? ios_base::dec : (b % 3 == 1 ? ios_base::hex : ios_base::oct));
+
+				stringstream stream;
+				stream.setf(base, ios_base::basefield);
+				stream << " " << largeIntA << " end";
+
+				LargeInt largeIntResult;
+				string rest;
+				stream >> largeIntResult >> rest;
+
+				if (largeIntResult != largeIntA || rest != "end" || stream.fail())
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) + (static_cast<uint64_t>(stopA) - startA) / 16384 * 54 << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				if (numB < 0)
+				{
+					cout << "Expected: the long random numbers seeded from a = " << numA << " to be read right" << endl;
+					continue;
+				}
+
+				const LargeInt largeIntA = LargeInt(numA) << (numB * 16);
+				const ios_base::fmtflags base = (numB % 3 == 0 ? ios_base::dec : (numB % 3 == 1 ? ios_base::hex : ios_base::oct));
+
+				stringstream stream;
+				stream.setf(base, ios_base::basefield);
+				stream << largeIntA;
+
+				LargeInt largeIntResult;
+				stream >> largeIntResult;
+
+				cout << "Expected: " << largeIntA << ", Got: " << largeIntResult << " from \"" << stream.str() << "\"" << endl;
+			}
+		}
+	}
+}
+
+void self_test_expr()
+{
+	using namespace std;
+
+	cout << "\nRunning expression template self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT16_MIN >> 6;
+	constexpr int32_t stopA = (INT16_MAX + 1) >> 6;
+	constexpr int32_t startB = INT16_MIN >> 6;
+	constexpr int32_t stopB = (INT16_MAX + 1) >> 6;
+
+	// Runs a few expressions both lazily and one operator at a time.
+	// The numbers are shifted up so they take a few limbs. Returns the expression that didn't match, or nullptr if they all did.
+	auto check = [](int64_t numA, int64_t numB) -> const char*
+	{
+		const LargeInt largeIntA = LargeInt(numA) << 100;
+		const LargeInt largeIntB = (LargeInt(numB) << 64) + LargeInt(numB);
+		const LargeInt largeIntC = LargeInt(numA - numB);
+
+		if (LargeInt(LargeInt::lazy(largeIntA) * largeIntB + largeIntC - largeIntA) != largeIntA * largeIntB + largeIntC - largeIntA)
+		{
+			return "a * b + c - a";
+		}
+
+		if (LargeInt(LargeInt::lazy(largeIntC) - LargeInt::lazy(largeIntA) * largeIntB) != largeIntC - largeIntA * largeIntB)
+		{
+			return "c - a * b";
+		}
+
+		// c only takes one limb, so these multiply it straight into the sum when the signs allow it
+		if (LargeInt(LargeInt::lazy(largeIntA) + LargeInt::lazy(largeIntB) * largeIntC) != largeIntA + largeIntB * largeIntC
+			|| LargeInt(LargeInt::lazy(largeIntA) - LargeInt::lazy(largeIntC) * largeIntB) != largeIntA - largeIntC * largeIntB)
+		{
+			return "a + b * c, a - c * b";
+		}
+
+		if (LargeInt((LargeInt::lazy(largeIntA) + largeIntB) * (LargeInt::lazy(largeIntB) - largeIntC)) != (largeIntA + largeIntB) * (largeIntB - largeIntC))
+		{
+			return "(a + b) * (b - c)";
+		}
+
+		// Every operator wraps around to its leftmost number's max size, so the product here gets cut down to 2 bytes before it's added
+		const LargeInt small_a = LargeInt(numA * 37, sizeof(int16_t));
+		const LargeInt small_c = LargeInt(numA * numB, sizeof(int32_t));
+		const LargeInt largeIntD = LargeInt(numB * 300);
+
+		if (!LargeInt(LargeInt::lazy(small_c) + LargeInt::lazy(small_a) * largeIntD).is_exactly_equal(small_c + small_a * largeIntD)
+			|| !LargeInt(LargeInt::lazy(small_c) - (LargeInt::lazy(small_a) - largeIntB) * largeIntD).is_exactly_equal(small_c - (small_a - largeIntB) * largeIntD)
+			|| !LargeInt(LargeInt::lazy(small_a) * largeIntD + small_c).is_exactly_equal(small_a * largeIntD + small_c)
+			|| !LargeInt(LargeInt::lazy(largeIntD) * small_c + small_a * largeIntB).is_exactly_equal(largeIntD * small_c + small_a * largeIntB))
+		{
+			return "max size";
+		}
+
+		return nullptr;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				if (check(numA, numB) != nullptr)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				const LargeInt largeIntA = LargeInt(numA) << 100;
+				const LargeInt largeIntB = (LargeInt(numB) << 64) + LargeInt(numB);
+				const LargeInt largeIntC = LargeInt(numA - numB);
+
+				cout << "Expected: " << check(numA, numB) << " to give the same result lazily with a = " << largeIntA << ", b = " << largeIntB << ", c = " << largeIntC << endl;
+			}
+		}
+	}
+}
+
+void self_test_rvalue()
+{
+	using namespace std;
+
+	cout << "\nRunning rvalue operator self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT16_MIN >> 6;
+	constexpr int32_t stopA = (INT16_MAX + 1) >> 6;
+	constexpr int32_t startB = INT16_MIN >> 6;
+	constexpr int32_t stopB = (INT16_MAX + 1) >> 6;
+
+	// Runs the same operations with temporaries on either side (which reuse their buffers) and with lvalues only (which copy).
+	// Returns the operation that didn't match, or nullptr if they all did.
+	auto check = [](int64_t numA, int64_t numB) -> const char*
+	{
+		const LargeInt largeIntA = LargeInt(numA) << 80;
+		const LargeInt largeIntB = LargeInt(numB);
+		const LargeInt sum = largeIntA + largeIntB;
+		const LargeInt difference = largeIntA - largeIntB;
+
+		if ((LargeInt(numA) << 80) + largeIntB != sum || largeIntA + LargeInt(numB) != sum || (LargeInt(numA) << 80) + LargeInt(numB) != sum)
+		{
+			return "a + b";
+		}
+
+		if ((LargeInt(numA) << 80) - largeIntB != difference || largeIntA - LargeInt(numB) != difference || (LargeInt(numA) << 80) - LargeInt(numB) != difference)
+		{
+			return "a - b";
+		}
+
+		if (((LargeInt(numA) + numB) - numA) + numB != LargeInt(numB * 2) || LargeInt(numA) - (LargeInt(numB) - (LargeInt(numA) + numB)) != LargeInt(numA * 2))
+		{
+			return "chains";
+		}
+
+		if (-(largeIntA - largeIntB) != largeIntB - largeIntA || -LargeInt(numA) != LargeInt(-numA) || ~LargeInt(numA) != LargeInt(~numA))
+		{
+			return "unary";
+		}
+
+		if ((LargeInt(numA) & LargeInt(numB)) != LargeInt(numA & numB) || (largeIntB | LargeInt(numA)) != LargeInt(numA | numB) || (LargeInt(numA) ^ largeIntB) != LargeInt(numA ^ numB))
+		{
+			return "bitwise";
+		}
+
+		if (((LargeInt(numA) << 3) >> 2) != LargeInt(numA * 2))
+		{
+			return "shifts";
+		}
+
+		// The result keeps the left side's max size even when it's built in the right side's buffer.
+		const LargeInt small_a(numA, sizeof(int8_t));
+		if (small_a + LargeInt(numB) != LargeInt(static_cast<int8_t>(numA + numB)) || small_a - LargeInt(numB) != LargeInt(static_cast<int8_t>(numA - numB)))
+		{
+			return "max size";
+		}
+
+		LargeInt self = largeIntA;
+		self += self;
+		if (self != largeIntA << 1 || (self -= self) != LargeInt(0))
+		{
+			return "self assignment";
+		}
+
+		return nullptr;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				if (check(numA, numB) != nullptr)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				cout << "Expected: " << check(numA, numB) << " to give the same result with temporaries with a = " << numA << ", b = " << numB << endl;
+			}
+		}
+	}
+}
+
+void self_test_constant()
+{
+	using namespace std;
+
+	cout << "\nRunning compile time constant self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	// These are all worked out by the compiler, so if they're wrong this doesn't even build.
+	static_assert(0xffff'ffff'ffff'ffff'ffff'ffff'ffff'ff61_li == 340282366920938463463374607431768211297_li);
+	static_assert(0b1010_li == 10_li && 017_li == 15_li && 0_li == -0_li);
+	static_assert(sizeof(18446744073709551615_li) < sizeof(18446744073709551616_li));
+	static_assert(2_li * 3_li - 7_li == -1_li && -5_li < 3_li && -5_li > -6_li);
+
+	constexpr int32_t startA = INT16_MIN >> 6;
+	constexpr int32_t stopA = (INT16_MAX + 1) >> 6;
+	constexpr int32_t startB = INT16_MIN >> 6;
+	constexpr int32_t stopB = (INT16_MAX + 1) >> 6;
+
+	// The constant arithmetic is constexpr, but it runs just as well at runtime, so check it against LargeInt.
+	// The numbers get multiplied by a constant over 2^64 so they take a few limbs. Returns the operation that didn't match, or nullptr if they all did.
+	auto check = [](int64_t numA, int64_t numB) -> const char*
+	{
+		constexpr auto factor = 18446744073709551629_li;
+		const LargeInt large_factor("18446744073709551629");
+
+		const LargeIntConstant<1> constantA({ static_cast<uint64_t>(numA < 0 ? -numA : numA) }, numA < 0);
+		const LargeIntConstant<1> constantB({ static_cast<uint64_t>(numB < 0 ? -numB : numB) }, numB < 0);
+		const LargeInt largeIntA = LargeInt(numA) * large_factor;
+		const LargeInt largeIntB = LargeInt(numB);
+
+		if (LargeInt(constantA) != LargeInt(numA) || LargeInt(-constantA) != LargeInt(-numA))
+		{
+			return "conversion";
+		}
+
+		if (LargeInt(constantA * factor + constantB) != largeIntA + largeIntB)
+		{
+			return "a * factor + b";
+		}
+
+		if (LargeInt(constantA * factor - constantB) != largeIntA - largeIntB)
+		{
+			return "a * factor - b";
+		}
+
+		if ((constantA * factor <=> constantB) != (largeIntA <=> largeIntB) || (constantA == constantB) != (numA == numB))
+		{
+			return "comparison";
+		}
+
+		if (largeIntA != constantA * factor || largeIntA + constantB != largeIntA + largeIntB)
+		{
+			return "with LargeInt";
+		}
+
+		return nullptr;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				if (check(numA, numB) != nullptr)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				cout << "Expected: " << check(numA, numB) << " to match LargeInt with a = " << numA << ", b = " << numB << endl;
+			}
+		}
+	}
+}
+
+void self_test_addmul()
+{
+	using namespace std;
+
+	cout << "\nRunning addmul/submul self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT16_MIN >> 6;
+	constexpr int32_t stopA = (INT16_MAX + 1) >> 6;
+	constexpr int32_t startB = INT16_MIN >> 6;
+	constexpr int32_t stopB = (INT16_MAX + 1) >> 6;
+
+	// Checks addmul() and submul() against multiplying and then adding.
+	// c is shifted up so the product takes a few limbs. Returns the function that didn't match, or nullptr if they all did.
+	auto check = [](int64_t numA, int64_t numB) -> const char*
+	{
+		const LargeInt largeIntA = LargeInt(numA);
+		const LargeInt largeIntB = LargeInt(numB);
+		const LargeInt largeIntC = (LargeInt(numA - numB) << 70) + LargeInt(numB);
+
+		if (LargeInt(largeIntC).addmul(largeIntA, largeIntB) != largeIntC + largeIntA * largeIntB || LargeInt(largeIntA).addmul(largeIntB, largeIntC) != largeIntA + largeIntB * largeIntC)
+		{
+			return "addmul";
+		}
+
+		if (LargeInt(largeIntC).submul(largeIntA, largeIntB) != largeIntC - largeIntA * largeIntB || LargeInt(largeIntA).submul(largeIntB, largeIntC) != largeIntA - largeIntB * largeIntC)
+		{
+			return "submul";
+		}
+
+		if (LargeInt(largeIntC).addmul(largeIntC, numA) != largeIntC + largeIntC * largeIntA || LargeInt(largeIntC).submul(largeIntC, numB) != largeIntC - largeIntC * largeIntB)
+		{
+			return "word addmul/submul";
+		}
+
+		if (LargeInt(largeIntC).addmul(largeIntA, static_cast<uint32_t>(numB)) != largeIntC + largeIntA * LargeInt(static_cast<uint32_t>(numB)))
+		{
+			return "unsigned word addmul";
+		}
+
+		LargeInt small_a(numA, sizeof(int16_t));
+		if (small_a.addmul(largeIntB, largeIntB * numA) != LargeInt(static_cast<int16_t>(numA + numB * numB * numA)))
+		{
+			return "max size";
+		}
+
+		// Both sides more than a limb, and then the number itself on every side
+		const LargeInt largeIntD = (largeIntC << 64) - largeIntA;
+
+		if (LargeInt(largeIntA).addmul(largeIntC, largeIntD) != largeIntA + largeIntC * largeIntD || LargeInt(largeIntB).submul(largeIntD, largeIntC) != largeIntB - largeIntD * largeIntC)
+		{
+			return "wide addmul/submul";
+		}
+
+		LargeInt same = largeIntD;
+		LargeInt same_word = largeIntD;
+
+		if (same.addmul(same, same) != largeIntD + largeIntD * largeIntD || same_word.submul(same_word, numB) != largeIntD - largeIntD * largeIntB)
+		{
+			return "addmul/submul on itself";
+		}
+
+		// Once the first call has made room, a word shouldn't allocate anything and two wide numbers only the scratch product
+		LargeInt accumulator = largeIntD << 300;
+		accumulator.addmul(largeIntD, numA);
+		accumulator.addmul(largeIntC, largeIntD);
+
+		size_t allocations = thread_allocations;
+		accumulator.addmul(largeIntD, numA);
+		accumulator.submul(largeIntC, static_cast<uint16_t>(numB));
+
+		if (thread_allocations != allocations)
+		{
+			return "word addmul/submul allocating";
+		}
+
+		allocations = thread_allocations;
+		accumulator.submul(largeIntC, largeIntD);
+
+		if (thread_allocations > allocations + 1)
+		{
+			return "addmul/submul allocating";
+		}
+
+		return nullptr;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				if (check(numA, numB) != nullptr)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				cout << "Expected: " << check(numA, numB) << " to match multiplying and adding with a = " << numA << ", b = " << numB << endl;
+			}
+		}
+	}
+}
+
+void self_test_reduce()
+{
+	using namespace std;
+
+	cout << "\nRunning product/sum self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT16_MIN >> 9;
+	constexpr int32_t stopA = (INT16_MAX + 1) >> 9;
+	constexpr int32_t startB = INT16_MIN >> 9;
+	constexpr int32_t stopB = (INT16_MAX + 1) >> 9;
+
+	// Checks product() and sum() against multiplying and adding one at a time, for ranges of integers and of LargeInts.
+	// Returns the function that didn't match, or nullptr if they all did.
+	auto check = [](int64_t numA, int64_t numB) -> const char*
+	{
+		const vector<int64_t> numbers = { numA, numB, numA - numB, INT64_MAX, numA * numB, -7, INT64_MIN };
+		vector<LargeInt> large_numbers = {};
+		LargeInt expected_product = 1;
+		LargeInt expected_sum = 0;
+
+		for (size_t i = 0; i < numbers.size(); i++)
+		{
+			large_numbers.push_back(LargeInt(numbers[i]) << (i * 40));
+			expected_product *= LargeInt(numbers[i]);
+			expected_sum += LargeInt(numbers[i]);
+		}
+
+		if (LargeInt::product(numbers) != expected_product || LargeInt::sum(numbers) != expected_sum)
+		{
+			return "integers";
+		}
+
+		expected_product = 1;
+		expected_sum = 0;
+
+		for (const auto& iter : large_numbers)
+		{
+			expected_product *= iter;
+			expected_sum += iter;
+		}
+
+		if (LargeInt::product(large_numbers) != expected_product || LargeInt::sum(large_numbers) != expected_sum)
+		{
+			return "LargeInts";
+		}
+
+		// 1 * 2 * ... * n, straight out of a view.
+		const uint64_t n = static_cast<uint64_t>(numA < 0 ? -numA : numA) % 64;
+		if (LargeInt::product(views::iota(uint64_t(1), n + 1)) != LargeInt::factorial(n) || LargeInt::sum(views::iota(uint64_t(1), n + 1)) != LargeInt(n * (n + 1) / 2))
+		{
+			return "iota";
+		}
+
+		if (LargeInt::product(vector<LargeInt>()) != LargeInt(1) || LargeInt::sum(vector<uint8_t>()) != LargeInt(0))
+		{
+			return "empty";
+		}
+
+		return nullptr;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				if (check(numA, numB) != nullptr)
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				const int64_t numA = inner_iter->first;
+				const int64_t numB = inner_iter->second;
+
+				cout << "Expected: " << check(numA, numB) << " to match multiplying and adding one at a time with a = " << numA << ", b = " << numB << endl;
+			}
+		}
+	}
+}
+
+void self_test_parallel()
+{
+	using namespace std;
+
+	cout << "\nRunning parallel multiplication self test. This may take a while...\n";
+
+	set_process_affinity();
+
+	constexpr int32_t startA = INT16_MIN >> 10;
+	constexpr int32_t stopA = (INT16_MAX + 1) >> 10;
+	constexpr int32_t startB = INT16_MIN >> 10;
+	constexpr int32_t stopB = (INT16_MAX + 1) >> 10;
+
+	// Low enough that the products below get split a couple of levels deep, with more threads than most machines have so they actually overlap.
+	LargeInt::set_parallel_multiplication(48, 8);
+
+	// Multiplies random numbers of a few hundred limbs, and checks the result against adding up a times one limb of b at a time,
+	// which never goes anywhere near the threads. Returns true if they matched.
+	auto check = [](int64_t numA, int64_t numB) -> bool
+	{
+		mt19937_64 generator(static_cast<uint64_t>(numA) * 65536 + static_cast<uint64_t>(numB));
+
+		vector<uint64_t> words(48 + static_cast<size_t>(numB - startB) * 4);
+		for (auto& iter : words)
+		{
+			iter = generator();
+		}
+
+		LargeInt largeIntA = LargeInt::random_bits(64 * (100 + static_cast<size_t>(numA - startA) * 3), generator);
+		if (numA < 0)
+		{
+			largeIntA = -largeIntA;
+		}
+
+		const LargeInt largeIntB = LargeInt::import_bits(span<const uint64_t>(words), numB < 0);
+
+		LargeInt expected = 0;
+		for (size_t i = 0; i < words.size(); i++)
+		{
+			expected.addmul(largeIntA << (64 * i), words[i]);
+		}
+
+		if (numB < 0)
+		{
+			expected = -expected;
+		}
+
+		return largeIntA * largeIntB == expected && largeIntB * largeIntA == expected;
+	};
+
+	const auto start = chrono::high_resolution_clock::now();
+
+	auto single_test = [&check](int32_t start, uint32_t step_size, vector<pair<int64_t, int64_t>>* failed_tests, uint64_t* num_failed_tests)
+	{
+		for (int32_t a = start; a < stopA; a += step_size)
+		{
+			for (int32_t b = startB; b < stopB; b++)
+			{
+				int64_t numA = static_cast<int64_t>(a);
+				int64_t numB = static_cast<int64_t>(b);
+
+				if (!check(numA, numB))
+				{
+					if (*num_failed_tests < max_reported_errors)
+					{
+						failed_tests->push_back(make_pair(numA, numB));
+					}
+					(*num_failed_tests)++;
+				}
+			}
+		}
+	};
+
+	unsigned int thread_count = static_cast<unsigned int>(trunc(max(thread::hardware_concurrency() * thread_count_mult * affinity_count_mult, 4.0)));
+	vector<jthread> threads = {};
+	vector<vector<pair<int64_t, int64_t>>> failed_tests = {};
+	vector<uint64_t> num_failed_tests = {};
+
+	failed_tests.reserve(thread_count);
+	num_failed_tests.reserve(thread_count);
+
+	for (unsigned int count = 0; count < thread_count; count++)
+	{
+		failed_tests.push_back(vector<pair<int64_t, int64_t>>(vector<pair<int64_t, int64_t>>()));
+		num_failed_tests.push_back(0);
+		threads.push_back(jthread(single_test, startA + count, thread_count, &(*failed_tests.rbegin()), &(*num_failed_tests.rbegin())));
+	}
+
+	for (auto& iter : threads)
+	{
+		iter.join();
+	}
+
+	uint64_t total_failed_tests = 0;
+
+	for (auto& iter : num_failed_tests)
+	{
+		total_failed_tests += iter;
+	}
+
+	// Running out of memory on one of the multiplication's threads should throw here like it would without threads, not end the program.
+	// Only this thread is left running, so it's the only one that gets to allocate.
+	bool allocation_failure_rethrown = false;
+
+	{
+		mt19937_64 generator(0);
+		const LargeInt largeIntA = LargeInt::random_bits(64 * 1000, generator);
+		const LargeInt largeIntB = LargeInt::random_bits(64 * 1000, generator);
+
+		thread_may_allocate = true;
+		fail_other_threads_allocations = true;
+
+		try
+		{
+			const LargeInt product = largeIntA * largeIntB;
+		}
+		catch (const bad_alloc&)
+		{
+			allocation_failure_rethrown = true;
+		}
+
+		fail_other_threads_allocations = false;
+		thread_may_allocate = false;
+	}
+
+	if (!allocation_failure_rethrown)
+	{
+		total_failed_tests++;
+	}
+
+	LargeInt::set_parallel_multiplication(LargeInt::default_parallel_threshold, thread::hardware_concurrency());
+
+	const auto stop = chrono::high_resolution_clock::now();
+	const auto duration = chrono::duration_cast<chrono::milliseconds>(stop - start);
+
+	cout << "Tests finished. Took: " << duration.count() / 1000 << "." << format("{:03}", duration.count() % 1000) << "s." << endl;
+	cout << "\nTotal tests done: " << (static_cast<uint64_t>(stopA) - startA) * (static_cast<uint64_t>(stopB) - startB) + 1 << endl;
+	cout << "Total failed tests: " << total_failed_tests << endl;
+
+	if (total_failed_tests > 0)
+	{
+		cout << "\nErrors encountered:\n";
+		uint64_t num_errors_reported = max_reported_errors;
+		for (auto outer_iter = failed_tests.begin(); outer_iter != failed_tests.end() && num_errors_reported > 0; outer_iter++)
+		{
+			for (auto inner_iter = outer_iter->begin(); inner_iter != outer_iter->end() && num_errors_reported > 0; inner_iter++, num_errors_reported--)
+			{
+				cout << "Expected: the parallel product to match with the numbers seeded from a = " << inner_iter->first << ", b = " << inner_iter->second << endl;
+			}
+		}
+
+		if (!allocation_failure_rethrown)
+		{
+			cout << "Expected: std::bad_alloc on a multiplication thread to be rethrown to the caller" << endl;
+		}
+	}
+}
@@ -8,3 +8,25 @@ void self_test_modulo();
 void self_test_bitwise();
 void self_test_bitshift();
 void self_test_unary();
+void self_test_gcd();
+void self_test_bits();
+void self_test_combinatorics();
+void self_test_primes();
+void self_test_random();
+void self_test_modint();
+void self_test_parse();
+void self_test_to_string();
+void self_test_format();
+void self_test_chars();
+void self_test_serialize();
+void self_test_file();
+void self_test_float();
+void self_test_import();
+void self_test_view();
+void self_test_stream();
+void self_test_expr();
+void self_test_rvalue();
+void self_test_constant();
+void self_test_addmul();
+void self_test_reduce();
+void self_test_parallel();